@@ -41,67 +41,479 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <string.h>
+#include <time.h>
+#ifdef __linux__
+#include <sys/sysinfo.h>
+#endif
 #include "coap_abstraction.h"
 
 #include <awa/static.h>
+#include "lwm2m-client-device-object.h"
+#include "lwm2m-client-libobjects-private.h"
 
 /***************************************************************************************************
  * Definitions
  **************************************************************************************************/
 
-#define LWM2M_DEVICE_OBJECT								            3
-#define LWM2M_DEVICE_OBJECT_MANUFACTURER                            0
-#define LWM2M_DEVICE_OBJECT_MODEL_NUMBER                            1
-#define LWM2M_DEVICE_OBJECT_SERIAL_NUMBER                           2
-#define LWM2M_DEVICE_OBJECT_FIRMWARE_VERSION                        3
-#define LWM2M_DEVICE_OBJECT_REBOOT                                  4
-#define LWM2M_DEVICE_OBJECT_FACTORY_RESET                           5
-#define LWM2M_DEVICE_OBJECT_AVAILABLE_POWER_SOURCES                 6
-#define LWM2M_DEVICE_OBJECT_POWER_SOURCE_VOLTAGE                    7
-#define LWM2M_DEVICE_OBJECT_POWER_SOURCE_CURRENT                    8
-#define LWM2M_DEVICE_OBJECT_BATTERY_LEVEL                           9
-#define LWM2M_DEVICE_OBJECT_MEMORY_FREE                             10
-#define LWM2M_DEVICE_OBJECT_ERROR_CODE                              11
-#define LWM2M_DEVICE_OBJECT_RESET_ERROR_CODE                        12
-#define LWM2M_DEVICE_OBJECT_CURRENT_TIME                            13
-#define LWM2M_DEVICE_OBJECT_UTC_OFFSET                              14
-#define LWM2M_DEVICE_OBJECT_TIME_ZONE                               15
-#define LWM2M_DEVICE_OBJECT_SUPPORTED_BINDING_AND_MODES             16
-#define LWM2M_DEVICE_OBJECT_DEVICE_TYPE                             17
-#define LWM2M_DEVICE_OBJECT_HARDWARE_VERSION                        18
-#define LWM2M_DEVICE_OBJECT_SOFTWARE_VERSION                        19
-#define LWM2M_DEVICE_OBJECT_BATTERY_STATUS                          20
-#define LWM2M_DEVICE_OBJECT_MEMORY_TOTAL                            21
-
-
-#define LWM2M_DEVICE_OBJECT_POWER_SOURCES_COUNT         7
-#define LWM2M_DEVICE_OBJECT_ERROR_CODE_COUNT            2
-
-typedef struct
+/* Samples of DeviceObject.SampleTimes, Power Source Voltage takes one per power source */
+#define DEVICE_SAMPLE_MEMORY_FREE                   0
+#define DEVICE_SAMPLE_MEMORY_TOTAL                  1
+#define DEVICE_SAMPLE_CURRENT_TIME                  2
+#define DEVICE_SAMPLE_BATTERY_LEVEL                 3
+#define DEVICE_SAMPLE_POWER_SOURCE_VOLTAGE          4
+
+/* Resources with providers, indices to Providers */
+#define DEVICE_PROVIDER_MEMORY_FREE                 0
+#define DEVICE_PROVIDER_MEMORY_TOTAL                1
+#define DEVICE_PROVIDER_CURRENT_TIME                2
+#define DEVICE_PROVIDER_BATTERY_LEVEL               3
+#define DEVICE_PROVIDER_POWER_SOURCE_VOLTAGE        4
+#define DEVICE_PROVIDERS                            5
+
+/* Bits of DeviceObject.Dirty, indices to DeviceDirtyResources */
+#define DEVICE_DIRTY_AVAILABLE_POWER_SOURCES        (1 << 0)
+#define DEVICE_DIRTY_POWER_SOURCE_VOLTAGE           (1 << 1)
+#define DEVICE_DIRTY_POWER_SOURCE_CURRENT           (1 << 2)
+#define DEVICE_DIRTY_ERROR_CODE                     (1 << 3)
+
+/***************************************************************************************************
+ * Globals
+ **************************************************************************************************/
+
+static DeviceObjectProvider Providers[DEVICE_PROVIDERS];
+
+/* Increased whenever a provider is replaced, invalidates the samples of all clients */
+static uint32_t ProviderGeneration;
+
+static const AwaResourceID DeviceDirtyResources[] = {
+    LWM2M_DEVICE_OBJECT_AVAILABLE_POWER_SOURCES,
+    LWM2M_DEVICE_OBJECT_POWER_SOURCE_VOLTAGE,
+    LWM2M_DEVICE_OBJECT_POWER_SOURCE_CURRENT,
+    LWM2M_DEVICE_OBJECT_ERROR_CODE,
+};
+
+/* Single instance of Error Code read while no error code is kept */
+static AwaInteger NoErrorCode;
+
+/***************************************************************************************************
+ * Implementation - Providers
+ **************************************************************************************************/
+
+static AwaError Device_ReadTime(AwaResourceID resourceID, AwaResourceInstanceID resourceInstanceID, AwaInteger *value)
+{
+    struct timespec now;
+    if (clock_gettime(CLOCK_REALTIME, &now) != 0)
+    {
+        return AwaError_Unspecified;
+    }
+    *value = now.tv_sec;
+    return AwaError_Success;
+}
+
+#ifdef __linux__
+
+/*
+ * Memory Free and Memory Total in KB.
+ */
+static AwaError Device_ReadMemory(AwaResourceID resourceID, AwaResourceInstanceID resourceInstanceID, AwaInteger *value)
+{
+    struct sysinfo info;
+    if (sysinfo(&info) != 0)
+    {
+        return AwaError_Unspecified;
+    }
+    *value = (AwaInteger)((resourceID == LWM2M_DEVICE_OBJECT_MEMORY_FREE) ? info.freeram : info.totalram) * info.mem_unit / 1024;
+    return AwaError_Success;
+}
+
+/*
+ * Battery Level in percent and Power Source Voltage in mV of the first power source, from LWM2M_DEVICE_POWER_SUPPLY.
+ */
+static AwaError Device_ReadPowerSupply(AwaResourceID resourceID, AwaResourceInstanceID resourceInstanceID, AwaInteger *value)
 {
-	char Manufacturer[64];
-	char ModelNumber[64];
-	char SerialNumber[64];
-	char FirmwareVersion[64];
-	AwaInteger AvailablePowerSources[LWM2M_DEVICE_OBJECT_POWER_SOURCES_COUNT];
-	AwaInteger PowerSourceVoltage[LWM2M_DEVICE_OBJECT_POWER_SOURCES_COUNT];
-	AwaInteger PowerSourceCurrent[LWM2M_DEVICE_OBJECT_POWER_SOURCES_COUNT];
-	AwaInteger BatteryLevel;
-	AwaInteger MemoryFree;
-	AwaInteger ErrorCode[LWM2M_DEVICE_OBJECT_ERROR_CODE_COUNT];
-	AwaTime CurrentTime;
-	char UTCOffset[16];
-	char Timezone[16];
-	char SupportedBindingandModes[4];
-	char DeviceType[64];
-	char HardwareVersion[64];
-	char SoftwareVersion[64];
-	AwaInteger BatteryStatus;
-	AwaInteger MemoryTotal;
-} DeviceObject;
-
-DeviceObject DeviceObjectStorage = { .SupportedBindingandModes = "U",
-                                     .SoftwareVersion = VERSION};
+    char path[96];
+    long long reading;
+    FILE *file;
+    int read;
+
+    if (resourceInstanceID != 0)
+    {
+        return AwaError_Unspecified;
+    }
+    snprintf(path, sizeof(path), "/sys/class/power_supply/%s/%s", LWM2M_DEVICE_POWER_SUPPLY,
+        (resourceID == LWM2M_DEVICE_OBJECT_BATTERY_LEVEL) ? "capacity" : "voltage_now");
+    file = fopen(path, "r");
+    if (file == NULL)
+    {
+        return AwaError_Unspecified;
+    }
+    read = fscanf(file, "%lld", &reading);
+    fclose(file);
+    if (read != 1)
+    {
+        return AwaError_Unspecified;
+    }
+    /* voltage_now is in uV */
+    *value = (resourceID == LWM2M_DEVICE_OBJECT_BATTERY_LEVEL) ? reading : reading / 1000;
+    return AwaError_Success;
+}
+
+static const DeviceObjectProvider DefaultProviders[DEVICE_PROVIDERS] = {
+    [DEVICE_PROVIDER_MEMORY_FREE] = Device_ReadMemory,
+    [DEVICE_PROVIDER_MEMORY_TOTAL] = Device_ReadMemory,
+    [DEVICE_PROVIDER_CURRENT_TIME] = Device_ReadTime,
+    [DEVICE_PROVIDER_BATTERY_LEVEL] = Device_ReadPowerSupply,
+    [DEVICE_PROVIDER_POWER_SOURCE_VOLTAGE] = Device_ReadPowerSupply,
+};
+
+#else
+
+static const DeviceObjectProvider DefaultProviders[DEVICE_PROVIDERS] = {
+    [DEVICE_PROVIDER_CURRENT_TIME] = Device_ReadTime,
+};
+
+#endif /* __linux__ */
+
+static int Device_ProviderIndex(AwaResourceID resourceID)
+{
+    switch (resourceID)
+    {
+        case LWM2M_DEVICE_OBJECT_MEMORY_FREE:
+            return DEVICE_PROVIDER_MEMORY_FREE;
+        case LWM2M_DEVICE_OBJECT_MEMORY_TOTAL:
+            return DEVICE_PROVIDER_MEMORY_TOTAL;
+        case LWM2M_DEVICE_OBJECT_CURRENT_TIME:
+            return DEVICE_PROVIDER_CURRENT_TIME;
+        case LWM2M_DEVICE_OBJECT_BATTERY_LEVEL:
+            return DEVICE_PROVIDER_BATTERY_LEVEL;
+        case LWM2M_DEVICE_OBJECT_POWER_SOURCE_VOLTAGE:
+            return DEVICE_PROVIDER_POWER_SOURCE_VOLTAGE;
+        default:
+            return -1;
+    }
+}
+
+AwaError DeviceObject_SetProvider(AwaResourceID resourceID, DeviceObjectProvider provider)
+{
+    int index = Device_ProviderIndex(resourceID);
+    if (index < 0)
+    {
+        printf("Invalid arguments passed to %s", __func__);
+        return AwaError_Unspecified;
+    }
+    Providers[index] = provider;
+    ProviderGeneration++;
+    return AwaError_Success;
+}
+
+/*
+ * Refreshes *value from the provider of the resource unless sample was taken less than LWM2M_DEVICE_CACHE_TTL ago.
+ * Current Time is never cached, reading the clock is cheaper than the check and a cached clock would stand still.
+ * Returns false, keeping the last value, if the provider fails.
+ */
+static bool Device_Sample(DeviceObject *device, AwaResourceID resourceID, AwaResourceInstanceID resourceInstanceID, int sample,
+    AwaInteger *value)
+{
+    int index = Device_ProviderIndex(resourceID);
+    DeviceObjectProvider provider = (Providers[index] != NULL) ? Providers[index] : DefaultProviders[index];
+    LibObjectsTime now;
+
+    if (device->Assigned & (1u << sample))
+    {
+        return true;
+    }
+    now = LibObjects_GetTime();
+    if (device->Generation != ProviderGeneration)
+    {
+        device->Generation = ProviderGeneration;
+        device->Sampled = 0;
+    }
+    if ((sample != DEVICE_SAMPLE_CURRENT_TIME) && (device->Sampled & (1u << sample)) &&
+        (now - device->SampleTimes[sample] < LWM2M_DEVICE_CACHE_TTL))
+    {
+        return true;
+    }
+    if ((provider == NULL) || (provider(resourceID, resourceInstanceID, value) != AwaError_Success))
+    {
+        return false;
+    }
+    if (resourceID == LWM2M_DEVICE_OBJECT_CURRENT_TIME)
+    {
+        *value += device->TimeOffset;
+    }
+    device->Sampled |= 1u << sample;
+    device->SampleTimes[sample] = now;
+    return true;
+}
+
+/***************************************************************************************************
+ * Implementation - Multiple instance resources
+ **************************************************************************************************/
+
+/*
+ * Notifies resources changed by an update now, or marks them dirty for LibObjects_Flush.
+ */
+static AwaError Device_Changed(AwaStaticClient *awaClient, uint8_t dirty)
+{
+#if LIBOBJECTS_DEFERRED_NOTIFY
+    LibObjectsContext *context = LibObjects_GetContext(awaClient);
+    if (dirty != 0)
+    {
+        LIBOBJECTS_SET_BITS(&context->Device.Dirty, dirty);
+        LIBOBJECTS_SET_BITS(&context->DirtyObjects, LIBOBJECTS_DIRTY_DEVICE);
+    }
+    return AwaError_Success;
+#else
+    return LibObjects_NotifyDirty(awaClient, LWM2M_DEVICE_OBJECT, 0, dirty, DeviceDirtyResources);
+#endif
+}
+
+void DeviceObject_Flush(AwaStaticClient *awaClient, LibObjectsContext *context)
+{
+    LibObjects_NotifyDirty(awaClient, LWM2M_DEVICE_OBJECT, 0, LIBOBJECTS_TAKE_BITS(&context->Device.Dirty), DeviceDirtyResources);
+}
+
+/*
+ * Creates the power source resources once there is a power source, so that they never exist without instances.
+ */
+static void Device_CreatePowerSources(AwaStaticClient *awaClient, DeviceObject *device)
+{
+    if ((device->PowerSources > 0) && !device->PowerSourcesCreated)
+    {
+        device->PowerSourcesCreated = true;
+        AwaStaticClient_CreateResource(awaClient, LWM2M_DEVICE_OBJECT, 0, LWM2M_DEVICE_OBJECT_AVAILABLE_POWER_SOURCES);
+        AwaStaticClient_CreateResource(awaClient, LWM2M_DEVICE_OBJECT, 0, LWM2M_DEVICE_OBJECT_POWER_SOURCE_VOLTAGE);
+        AwaStaticClient_CreateResource(awaClient, LWM2M_DEVICE_OBJECT, 0, LWM2M_DEVICE_OBJECT_POWER_SOURCE_CURRENT);
+    }
+}
+
+/*
+ * Stores power source index, returns DEVICE_DIRTY_* bits of the resources it changed.
+ */
+static uint8_t Device_StorePowerSource(DeviceObject *device, int index, AwaInteger type, AwaInteger voltage, AwaInteger current)
+{
+    uint32_t sample = 1u << (DEVICE_SAMPLE_POWER_SOURCE_VOLTAGE + index);
+    uint8_t dirty = 0;
+
+    if (index >= device->PowerSources)
+    {
+        dirty = DEVICE_DIRTY_AVAILABLE_POWER_SOURCES | DEVICE_DIRTY_POWER_SOURCE_VOLTAGE | DEVICE_DIRTY_POWER_SOURCE_CURRENT;
+    }
+    if (device->AvailablePowerSources[index] != type)
+    {
+        device->AvailablePowerSources[index] = type;
+        dirty |= DEVICE_DIRTY_AVAILABLE_POWER_SOURCES;
+    }
+    if (device->PowerSourceCurrent[index] != current)
+    {
+        device->PowerSourceCurrent[index] = current;
+        dirty |= DEVICE_DIRTY_POWER_SOURCE_CURRENT;
+    }
+    if (voltage == LWM2M_DEVICE_SAMPLED_VOLTAGE)
+    {
+        if (device->Assigned & sample)
+        {
+            device->Assigned &= ~sample;
+            device->Sampled &= ~sample;
+            dirty |= DEVICE_DIRTY_POWER_SOURCE_VOLTAGE;
+        }
+    }
+    else if (!(device->Assigned & sample) || (device->PowerSourceVoltage[index] != voltage))
+    {
+        device->Assigned |= sample;
+        device->PowerSourceVoltage[index] = voltage;
+        dirty |= DEVICE_DIRTY_POWER_SOURCE_VOLTAGE;
+    }
+    return dirty;
+}
+
+AwaError DeviceObject_SetPowerSources(AwaStaticClient *awaClient, const DeviceObjectPowerSource *sources, size_t count)
+{
+    DeviceObject *device;
+    uint8_t dirty = 0;
+    size_t index;
+
+    if ((awaClient == NULL) || ((sources == NULL) && (count > 0)) || (count > LWM2M_DEVICE_OBJECT_POWER_SOURCES_COUNT))
+    {
+        printf("Invalid arguments passed to %s", __func__);
+        return AwaError_Unspecified;
+    }
+
+    device = &LibObjects_GetContext(awaClient)->Device;
+    for (index = 0; index < count; index++)
+    {
+        dirty |= Device_StorePowerSource(device, index, sources[index].Type, sources[index].Voltage, sources[index].Current);
+    }
+    if (count < device->PowerSources)
+    {
+        for (index = count; index < device->PowerSources; index++)
+        {
+            device->Assigned &= ~(1u << (DEVICE_SAMPLE_POWER_SOURCE_VOLTAGE + index));
+        }
+        dirty = DEVICE_DIRTY_AVAILABLE_POWER_SOURCES | DEVICE_DIRTY_POWER_SOURCE_VOLTAGE | DEVICE_DIRTY_POWER_SOURCE_CURRENT;
+    }
+    device->PowerSources = count;
+    Device_CreatePowerSources(awaClient, device);
+    return Device_Changed(awaClient, dirty);
+}
+
+AwaError DeviceObject_SetPowerSource(AwaStaticClient *awaClient, AwaResourceInstanceID index, AwaInteger type, AwaInteger voltage,
+    AwaInteger current)
+{
+    DeviceObject *device;
+    uint8_t dirty;
+
+    if ((awaClient == NULL) || (index < 0) || (index >= LWM2M_DEVICE_OBJECT_POWER_SOURCES_COUNT))
+    {
+        printf("Invalid arguments passed to %s", __func__);
+        return AwaError_Unspecified;
+    }
+
+    device = &LibObjects_GetContext(awaClient)->Device;
+    if (index > device->PowerSources)
+    {
+        printf("Invalid arguments passed to %s", __func__);
+        return AwaError_Unspecified;
+    }
+    dirty = Device_StorePowerSource(device, index, type, voltage, current);
+    if (index == device->PowerSources)
+    {
+        device->PowerSources++;
+    }
+    Device_CreatePowerSources(awaClient, device);
+    return Device_Changed(awaClient, dirty);
+}
+
+AwaError DeviceObject_PushErrorCodes(AwaStaticClient *awaClient, const AwaInteger *errorCodes, size_t count)
+{
+    DeviceObject *device;
+    bool added = false;
+    size_t index;
+
+    if ((awaClient == NULL) || ((errorCodes == NULL) && (count > 0)))
+    {
+        printf("Invalid arguments passed to %s", __func__);
+        return AwaError_Unspecified;
+    }
+
+    device = &LibObjects_GetContext(awaClient)->Device;
+    for (index = 0; index < count; index++)
+    {
+        int slot;
+        int kept;
+
+        if (errorCodes[index] == 0)
+        {
+            continue;
+        }
+        for (kept = 0, slot = device->FirstErrorCode; kept < device->ErrorCodes; kept++)
+        {
+            if (device->ErrorCode[slot] == errorCodes[index])
+            {
+                break;
+            }
+            slot = (slot + 1 == LWM2M_DEVICE_OBJECT_ERROR_CODE_COUNT) ? 0 : slot + 1;
+        }
+        if (kept < device->ErrorCodes)
+        {
+            continue;
+        }
+        if (device->ErrorCodes == LWM2M_DEVICE_OBJECT_ERROR_CODE_COUNT)
+        {
+            /* slot wrapped around to the oldest code */
+            device->FirstErrorCode = (slot + 1 == LWM2M_DEVICE_OBJECT_ERROR_CODE_COUNT) ? 0 : slot + 1;
+            device->ErrorCodes--;
+        }
+        device->ErrorCode[slot] = errorCodes[index];
+        device->ErrorCodes++;
+        added = true;
+    }
+    return Device_Changed(awaClient, added ? DEVICE_DIRTY_ERROR_CODE : 0);
+}
+
+AwaError DeviceObject_PushErrorCode(AwaStaticClient *awaClient, AwaInteger errorCode)
+{
+    return DeviceObject_PushErrorCodes(awaClient, &errorCode, 1);
+}
+
+/*
+ * Serves the power source and error code resources, which have as many instances as have been set.
+ */
+static AwaResult Device_InstancesHandler(AwaStaticClient *client, AwaOperation operation, AwaObjectID objectID,
+    AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, AwaResourceInstanceID resourceInstanceID, void **dataPointer,
+    size_t *dataSize, bool *changed)
+{
+    DeviceObject *device = &LibObjects_GetContext(client)->Device;
+    AwaInteger *value;
+
+    switch (operation)
+    {
+        case AwaOperation_CreateResource:
+            return AwaResult_SuccessCreated;
+
+        case AwaOperation_Execute:
+            if (resourceID != LWM2M_DEVICE_OBJECT_RESET_ERROR_CODE)
+            {
+                return AwaResult_MethodNotAllowed;
+            }
+            if (device->ErrorCodes > 0)
+            {
+                device->FirstErrorCode = 0;
+                device->ErrorCodes = 0;
+                Device_Changed(client, DEVICE_DIRTY_ERROR_CODE);
+            }
+            return AwaResult_Success;
+
+        case AwaOperation_Read:
+            break;
+
+        default:
+            return AwaResult_MethodNotAllowed;
+    }
+
+    if (resourceInstanceID < 0)
+    {
+        return AwaResult_NotFound;
+    }
+    switch (resourceID)
+    {
+        case LWM2M_DEVICE_OBJECT_AVAILABLE_POWER_SOURCES:
+        case LWM2M_DEVICE_OBJECT_POWER_SOURCE_CURRENT:
+            if (resourceInstanceID >= device->PowerSources)
+            {
+                return AwaResult_NotFound;
+            }
+            value = (resourceID == LWM2M_DEVICE_OBJECT_AVAILABLE_POWER_SOURCES) ? &device->AvailablePowerSources[resourceInstanceID] :
+                &device->PowerSourceCurrent[resourceInstanceID];
+            break;
+
+        case LWM2M_DEVICE_OBJECT_ERROR_CODE:
+            if (device->ErrorCodes == 0)
+            {
+                if (resourceInstanceID != 0)
+                {
+                    return AwaResult_NotFound;
+                }
+                value = &NoErrorCode;
+            }
+            else if (resourceInstanceID < device->ErrorCodes)
+            {
+                value = &device->ErrorCode[(device->FirstErrorCode + resourceInstanceID) % LWM2M_DEVICE_OBJECT_ERROR_CODE_COUNT];
+            }
+            else
+            {
+                return AwaResult_NotFound;
+            }
+            break;
+
+        default:
+            return AwaResult_InternalError;
+    }
+
+    *dataPointer = value;
+    *dataSize = sizeof(AwaInteger);
+    return AwaResult_SuccessContent;
+}
 
 /***************************************************************************************************
  * Implementation - Public
@@ -125,104 +537,226 @@ AwaResult executeHandler(AwaStaticClient *client, AwaOperation operation, AwaObj
     return result;
 }
 
+/*
+ * Serves the writable string resources, which keep their length so reads neither scan nor pad them.
+ */
+static AwaResult Device_StringHandler(AwaStaticClient *client, AwaOperation operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID,
+    AwaResourceID resourceID, AwaResourceInstanceID resourceInstanceID, void **dataPointer, size_t *dataSize, bool *changed)
+{
+    DeviceObject *device = &LibObjects_GetContext(client)->Device;
+    char *value;
+    uint16_t *length;
+    size_t capacity;
+
+    switch (resourceID)
+    {
+        case LWM2M_DEVICE_OBJECT_UTC_OFFSET:
+            value = device->UTCOffset.Value;
+            length = &device->UTCOffset.Length;
+            capacity = sizeof(device->UTCOffset.Value);
+            break;
+
+        case LWM2M_DEVICE_OBJECT_TIME_ZONE:
+            value = device->Timezone.Value;
+            length = &device->Timezone.Length;
+            capacity = sizeof(device->Timezone.Value);
+            break;
+
+        default:
+            return AwaResult_InternalError;
+    }
+
+    switch (operation)
+    {
+        case AwaOperation_CreateResource:
+            return AwaResult_SuccessCreated;
+
+        case AwaOperation_Read:
+            *dataPointer = value;
+            *dataSize = *length;
+            return AwaResult_SuccessContent;
+
+        case AwaOperation_Write:
+            if (!LibObjectsString_Store(value, length, capacity, *dataPointer, *dataSize))
+            {
+                return AwaResult_BadRequest;
+            }
+            *changed = true;
+            return AwaResult_SuccessChanged;
+
+        default:
+            return AwaResult_InternalError;
+    }
+}
+
+/*
+ * Serves the resources sampled from providers on read.
+ */
+static AwaResult Device_SampleHandler(AwaStaticClient *client, AwaOperation operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID,
+    AwaResourceID resourceID, AwaResourceInstanceID resourceInstanceID, void **dataPointer, size_t *dataSize, bool *changed)
+{
+    DeviceObject *device = &LibObjects_GetContext(client)->Device;
+    AwaInteger *value;
+    int sample;
+
+    switch (resourceID)
+    {
+        case LWM2M_DEVICE_OBJECT_MEMORY_FREE:
+            value = &device->MemoryFree;
+            sample = DEVICE_SAMPLE_MEMORY_FREE;
+            break;
+
+        case LWM2M_DEVICE_OBJECT_MEMORY_TOTAL:
+            value = &device->MemoryTotal;
+            sample = DEVICE_SAMPLE_MEMORY_TOTAL;
+            break;
+
+        case LWM2M_DEVICE_OBJECT_CURRENT_TIME:
+            value = &device->CurrentTime;
+            sample = DEVICE_SAMPLE_CURRENT_TIME;
+            break;
+
+        case LWM2M_DEVICE_OBJECT_BATTERY_LEVEL:
+            value = &device->BatteryLevel;
+            sample = DEVICE_SAMPLE_BATTERY_LEVEL;
+            break;
+
+        case LWM2M_DEVICE_OBJECT_POWER_SOURCE_VOLTAGE:
+            if ((resourceInstanceID < 0) || (resourceInstanceID >= device->PowerSources))
+            {
+                return AwaResult_NotFound;
+            }
+            value = &device->PowerSourceVoltage[resourceInstanceID];
+            sample = DEVICE_SAMPLE_POWER_SOURCE_VOLTAGE + resourceInstanceID;
+            break;
+
+        default:
+            return AwaResult_InternalError;
+    }
+
+    switch (operation)
+    {
+        case AwaOperation_CreateResource:
+            return AwaResult_SuccessCreated;
+
+        case AwaOperation_Read:
+            Device_Sample(device, resourceID, resourceInstanceID, sample, value);
+            *dataPointer = value;
+            *dataSize = sizeof(AwaInteger);
+            return AwaResult_SuccessContent;
+
+        case AwaOperation_Write:
+            if ((resourceID != LWM2M_DEVICE_OBJECT_CURRENT_TIME) || (*dataSize != sizeof(AwaTime)))
+            {
+                return AwaResult_MethodNotAllowed;
+            }
+            device->Sampled &= ~(1u << sample);
+            if (!Device_Sample(device, resourceID, resourceInstanceID, sample, value))
+            {
+                /* The offset is relative to the provider's time, which is not known */
+                return AwaResult_InternalError;
+            }
+            device->TimeOffset += *(AwaTime *)*dataPointer - *value;
+            *value = *(AwaTime *)*dataPointer;
+            *changed = true;
+            return AwaResult_SuccessChanged;
+
+        default:
+            return AwaResult_InternalError;
+    }
+}
 
 int DefineDeviceObject(AwaStaticClient *awaClient)
 {
+    DeviceObject *device = &LibObjects_GetContext(awaClient)->Device;
+
     AwaStaticClient_DefineObject(awaClient, LWM2M_DEVICE_OBJECT, "Device", 1, 1);
     AwaStaticClient_DefineResource(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_MANUFACTURER, "Manufacturer", AwaResourceType_String, 0, 1,
         AwaResourceOperations_ReadOnly);
-    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_MANUFACTURER, DeviceObjectStorage.Manufacturer,
-        sizeof(DeviceObjectStorage.Manufacturer), 0);
+    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_MANUFACTURER,
+        LIBOBJECTS_STRING_STORAGE(LIBOBJECTS_STRING_DEVICE_MANUFACTURER), 0);
 
     AwaStaticClient_DefineResource(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_MODEL_NUMBER, "ModelNumber", AwaResourceType_String, 0, 1,
         AwaResourceOperations_ReadOnly);
-    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_MODEL_NUMBER, DeviceObjectStorage.ModelNumber,
-        sizeof(DeviceObjectStorage.ModelNumber), 0);
+    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_MODEL_NUMBER,
+        LIBOBJECTS_STRING_STORAGE(LIBOBJECTS_STRING_DEVICE_MODEL_NUMBER), 0);
 
     AwaStaticClient_DefineResource(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_SERIAL_NUMBER, "SerialNumber", AwaResourceType_String, 0, 1,
         AwaResourceOperations_ReadOnly);
-    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_SERIAL_NUMBER, DeviceObjectStorage.SerialNumber,
-        sizeof(DeviceObjectStorage.SerialNumber), 0);
+    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_SERIAL_NUMBER,
+        LIBOBJECTS_STRING_STORAGE(LIBOBJECTS_STRING_DEVICE_SERIAL_NUMBER), 0);
 
     AwaStaticClient_DefineResource(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_FIRMWARE_VERSION, "FirmwareVersion", AwaResourceType_String, 0, 1,
         AwaResourceOperations_ReadOnly);
-    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_FIRMWARE_VERSION, DeviceObjectStorage.FirmwareVersion,
-        sizeof(DeviceObjectStorage.FirmwareVersion), 0);
+    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_FIRMWARE_VERSION,
+        LIBOBJECTS_STRING_STORAGE(LIBOBJECTS_STRING_DEVICE_FIRMWARE_VERSION), 0);
 
     AwaStaticClient_DefineResource(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_AVAILABLE_POWER_SOURCES, "AvailablePowerSources",
         AwaResourceType_Integer, 0, LWM2M_DEVICE_OBJECT_POWER_SOURCES_COUNT, AwaResourceOperations_ReadOnly);
-    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_AVAILABLE_POWER_SOURCES,
-        DeviceObjectStorage.AvailablePowerSources, sizeof(AwaInteger), 0);
+    AwaStaticClient_SetResourceOperationHandler(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_AVAILABLE_POWER_SOURCES,
+        Device_InstancesHandler);
 
     AwaStaticClient_DefineResource(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_POWER_SOURCE_VOLTAGE, "PowerSourceVoltage", AwaResourceType_Integer, 0,
         LWM2M_DEVICE_OBJECT_POWER_SOURCES_COUNT, AwaResourceOperations_ReadOnly);
-    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_POWER_SOURCE_VOLTAGE,
-        DeviceObjectStorage.PowerSourceVoltage, sizeof(AwaInteger), 0);
+    AwaStaticClient_SetResourceOperationHandler(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_POWER_SOURCE_VOLTAGE, Device_SampleHandler);
 
     AwaStaticClient_DefineResource(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_POWER_SOURCE_CURRENT, "PowerSourceCurrent", AwaResourceType_Integer, 0,
         LWM2M_DEVICE_OBJECT_POWER_SOURCES_COUNT, AwaResourceOperations_ReadOnly);
-    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_POWER_SOURCE_CURRENT,
-        DeviceObjectStorage.PowerSourceCurrent, sizeof(AwaInteger), 0);
+    AwaStaticClient_SetResourceOperationHandler(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_POWER_SOURCE_CURRENT,
+        Device_InstancesHandler);
 
     AwaStaticClient_DefineResource(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_BATTERY_LEVEL, "BatteryLevel", AwaResourceType_Integer, 0,
         1, AwaResourceOperations_ReadOnly);
-    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_BATTERY_LEVEL, &DeviceObjectStorage.BatteryLevel,
-        sizeof(AwaInteger), 0 );
+    AwaStaticClient_SetResourceOperationHandler(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_BATTERY_LEVEL, Device_SampleHandler);
 
     AwaStaticClient_DefineResource(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_MEMORY_FREE, "MemoryFree", AwaResourceType_Integer, 0,
         1, AwaResourceOperations_ReadOnly);
-    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_MEMORY_FREE, &DeviceObjectStorage.MemoryFree,
-        sizeof(AwaInteger), 0 );
+    AwaStaticClient_SetResourceOperationHandler(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_MEMORY_FREE, Device_SampleHandler);
 
     AwaStaticClient_DefineResource(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_ERROR_CODE, "ErrorCode", AwaResourceType_Integer, 0,
         LWM2M_DEVICE_OBJECT_ERROR_CODE_COUNT, AwaResourceOperations_ReadOnly);
-    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_ERROR_CODE, DeviceObjectStorage.ErrorCode,
-        sizeof(AwaInteger), 0);
+    AwaStaticClient_SetResourceOperationHandler(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_ERROR_CODE, Device_InstancesHandler);
 
     AwaStaticClient_DefineResource(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_CURRENT_TIME, "CurrentTime", AwaResourceType_Time, 0,
         1, AwaResourceOperations_ReadWrite);
-    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_CURRENT_TIME, &DeviceObjectStorage.CurrentTime,
-        sizeof(AwaTime), 0);
+    AwaStaticClient_SetResourceOperationHandler(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_CURRENT_TIME, Device_SampleHandler);
 
     AwaStaticClient_DefineResource(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_UTC_OFFSET, "UTCOffset", AwaResourceType_String, 0, 1,
         AwaResourceOperations_ReadWrite);
-    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_UTC_OFFSET, DeviceObjectStorage.UTCOffset,
-        sizeof(DeviceObjectStorage.UTCOffset), 0);
+    AwaStaticClient_SetResourceOperationHandler(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_UTC_OFFSET, Device_StringHandler);
 
     AwaStaticClient_DefineResource(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_TIME_ZONE, "Timezone", AwaResourceType_String, 0, 1,
         AwaResourceOperations_ReadWrite);
-    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_TIME_ZONE, DeviceObjectStorage.Timezone,
-        sizeof(DeviceObjectStorage.Timezone), 0);
+    AwaStaticClient_SetResourceOperationHandler(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_TIME_ZONE, Device_StringHandler);
 
     AwaStaticClient_DefineResource(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_SUPPORTED_BINDING_AND_MODES, "SupportedBindingandModes",
         AwaResourceType_String, 1, 1, AwaResourceOperations_ReadOnly);
     AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_SUPPORTED_BINDING_AND_MODES,
-        DeviceObjectStorage.SupportedBindingandModes, sizeof(DeviceObjectStorage.SupportedBindingandModes), 0);
+        LIBOBJECTS_STRING_STORAGE(LIBOBJECTS_STRING_DEVICE_BINDING_AND_MODES), 0);
 
     AwaStaticClient_DefineResource(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_DEVICE_TYPE, "DeviceType", AwaResourceType_String, 1, 1,
         AwaResourceOperations_ReadOnly);
-    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_DEVICE_TYPE, DeviceObjectStorage.DeviceType,
-        sizeof(DeviceObjectStorage.DeviceType), 0);
+    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_DEVICE_TYPE,
+        LIBOBJECTS_STRING_STORAGE(LIBOBJECTS_STRING_DEVICE_TYPE), 0);
 
     AwaStaticClient_DefineResource(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_HARDWARE_VERSION, "HardwareVersion", AwaResourceType_String, 0, 1,
         AwaResourceOperations_ReadOnly);
-    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_HARDWARE_VERSION, DeviceObjectStorage.HardwareVersion,
-        sizeof(DeviceObjectStorage.HardwareVersion), 0);
+    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_HARDWARE_VERSION,
+        LIBOBJECTS_STRING_STORAGE(LIBOBJECTS_STRING_DEVICE_HARDWARE_VERSION), 0);
 
     AwaStaticClient_DefineResource(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_SOFTWARE_VERSION, "SoftwareVersion", AwaResourceType_String, 0, 1,
         AwaResourceOperations_ReadOnly);
-    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_SOFTWARE_VERSION, DeviceObjectStorage.SoftwareVersion,
-        sizeof(DeviceObjectStorage.SoftwareVersion), 0);
+    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_SOFTWARE_VERSION,
+        LIBOBJECTS_STRING_STORAGE(LIBOBJECTS_STRING_DEVICE_SOFTWARE_VERSION), 0);
 
     AwaStaticClient_DefineResource(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_BATTERY_STATUS, "BatteryStatus", AwaResourceType_Integer, 0, 1,
         AwaResourceOperations_ReadOnly);
-    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_BATTERY_STATUS, &DeviceObjectStorage.BatteryStatus ,
+    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_BATTERY_STATUS, &device->BatteryStatus ,
         sizeof(AwaInteger), 0 );
 
     AwaStaticClient_DefineResource(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_MEMORY_TOTAL, "MemoryTotal", AwaResourceType_Integer, 0, 1,
         AwaResourceOperations_ReadOnly);
-    AwaStaticClient_SetResourceStorageWithPointer(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_MEMORY_TOTAL, &DeviceObjectStorage.MemoryTotal ,
-        sizeof(AwaInteger), 0 );
+    AwaStaticClient_SetResourceOperationHandler(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_MEMORY_TOTAL, Device_SampleHandler);
 
     AwaStaticClient_DefineResource(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_REBOOT, "Reboot", AwaResourceType_None, 0, 1,
         AwaResourceOperations_Execute);
@@ -234,7 +768,7 @@ int DefineDeviceObject(AwaStaticClient *awaClient)
 
     AwaStaticClient_DefineResource(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_RESET_ERROR_CODE, "ResetErrorCode", AwaResourceType_None, 0, 1,
         AwaResourceOperations_Execute);
-    AwaStaticClient_SetResourceOperationHandler(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_RESET_ERROR_CODE, executeHandler);
+    AwaStaticClient_SetResourceOperationHandler(awaClient, LWM2M_DEVICE_OBJECT, LWM2M_DEVICE_OBJECT_RESET_ERROR_CODE, Device_InstancesHandler);
 
     AwaStaticClient_CreateObjectInstance(awaClient, LWM2M_DEVICE_OBJECT, 0);
 
@@ -243,18 +777,22 @@ int DefineDeviceObject(AwaStaticClient *awaClient)
 //    AwaStaticClient_CreateResource(awaClient, LWM2M_DEVICE_OBJECT, 0, LWM2M_DEVICE_OBJECT_SERIAL_NUMBER);
 //    AwaStaticClient_CreateResource(awaClient, LWM2M_DEVICE_OBJECT, 0, LWM2M_DEVICE_OBJECT_FIRMWARE_VERSION);
 //    AwaStaticClient_CreateResource(awaClient, LWM2M_DEVICE_OBJECT, 0, LWM2M_DEVICE_OBJECT_AVAILABLE_POWER_SOURCES);
-//	AwaStaticClient_CreateResource(awaClient, LWM2M_DEVICE_OBJECT, 0, LWM2M_DEVICE_OBJECT_POWER_SOURCE_VOLTAGE);
+//    AwaStaticClient_CreateResource(awaClient, LWM2M_DEVICE_OBJECT, 0, LWM2M_DEVICE_OBJECT_POWER_SOURCE_VOLTAGE);
 //    AwaStaticClient_CreateResource(awaClient, LWM2M_DEVICE_OBJECT, 0, LWM2M_DEVICE_OBJECT_POWER_SOURCE_CURRENT);
 //    AwaStaticClient_CreateResource(awaClient, LWM2M_DEVICE_OBJECT, 0, LWM2M_DEVICE_OBJECT_BATTERY_LEVEL);
-//    AwaStaticClient_CreateResource(awaClient, LWM2M_DEVICE_OBJECT, 0, LWM2M_DEVICE_OBJECT_MEMORY_FREE);
-//    AwaStaticClient_CreateResource(awaClient, LWM2M_DEVICE_OBJECT, 0, LWM2M_DEVICE_OBJECT_CURRENT_TIME);
+    AwaStaticClient_CreateResource(awaClient, LWM2M_DEVICE_OBJECT, 0, LWM2M_DEVICE_OBJECT_MEMORY_FREE);
+    AwaStaticClient_CreateResource(awaClient, LWM2M_DEVICE_OBJECT, 0, LWM2M_DEVICE_OBJECT_ERROR_CODE);
+    AwaStaticClient_CreateResource(awaClient, LWM2M_DEVICE_OBJECT, 0, LWM2M_DEVICE_OBJECT_CURRENT_TIME);
 //    AwaStaticClient_CreateResource(awaClient, LWM2M_DEVICE_OBJECT, 0, LWM2M_DEVICE_OBJECT_UTC_OFFSET);
 //    AwaStaticClient_CreateResource(awaClient, LWM2M_DEVICE_OBJECT, 0, LWM2M_DEVICE_OBJECT_TIME_ZONE);
 //    AwaStaticClient_CreateResource(awaClient, LWM2M_DEVICE_OBJECT, 0, LWM2M_DEVICE_OBJECT_DEVICE_TYPE);
 //    AwaStaticClient_CreateResource(awaClient, LWM2M_DEVICE_OBJECT, 0, LWM2M_DEVICE_OBJECT_HARDWARE_VERSION);
     AwaStaticClient_CreateResource(awaClient, LWM2M_DEVICE_OBJECT, 0, LWM2M_DEVICE_OBJECT_SOFTWARE_VERSION);
 //    AwaStaticClient_CreateResource(awaClient, LWM2M_DEVICE_OBJECT, 0, LWM2M_DEVICE_OBJECT_BATTERY_STATUS);
-//    AwaStaticClient_CreateResource(awaClient, LWM2M_DEVICE_OBJECT, 0, LWM2M_DEVICE_OBJECT_MEMORY_TOTAL);
+    AwaStaticClient_CreateResource(awaClient, LWM2M_DEVICE_OBJECT, 0, LWM2M_DEVICE_OBJECT_MEMORY_TOTAL);
+    /* Power sources may have been set before the object was defined */
+    device->PowerSourcesCreated = false;
+    Device_CreatePowerSources(awaClient, device);
 
     return 0;
 }
@@ -36,6 +36,157 @@
 #ifndef LIBOBJECTS_LWM2M_CLIENT_DEVICE_OBJECT_H_
 #define LIBOBJECTS_LWM2M_CLIENT_DEVICE_OBJECT_H_
 
+#include "awa/static.h"
+
+/***************************************************************************************************
+ * Macros
+ **************************************************************************************************/
+
+#define LWM2M_DEVICE_OBJECT                                         3
+#define LWM2M_DEVICE_OBJECT_MANUFACTURER                            0
+#define LWM2M_DEVICE_OBJECT_MODEL_NUMBER                            1
+#define LWM2M_DEVICE_OBJECT_SERIAL_NUMBER                           2
+#define LWM2M_DEVICE_OBJECT_FIRMWARE_VERSION                        3
+#define LWM2M_DEVICE_OBJECT_REBOOT                                  4
+#define LWM2M_DEVICE_OBJECT_FACTORY_RESET                           5
+#define LWM2M_DEVICE_OBJECT_AVAILABLE_POWER_SOURCES                 6
+#define LWM2M_DEVICE_OBJECT_POWER_SOURCE_VOLTAGE                    7
+#define LWM2M_DEVICE_OBJECT_POWER_SOURCE_CURRENT                    8
+#define LWM2M_DEVICE_OBJECT_BATTERY_LEVEL                           9
+#define LWM2M_DEVICE_OBJECT_MEMORY_FREE                             10
+#define LWM2M_DEVICE_OBJECT_ERROR_CODE                              11
+#define LWM2M_DEVICE_OBJECT_RESET_ERROR_CODE                        12
+#define LWM2M_DEVICE_OBJECT_CURRENT_TIME                            13
+#define LWM2M_DEVICE_OBJECT_UTC_OFFSET                              14
+#define LWM2M_DEVICE_OBJECT_TIME_ZONE                               15
+#define LWM2M_DEVICE_OBJECT_SUPPORTED_BINDING_AND_MODES             16
+#define LWM2M_DEVICE_OBJECT_DEVICE_TYPE                             17
+#define LWM2M_DEVICE_OBJECT_HARDWARE_VERSION                        18
+#define LWM2M_DEVICE_OBJECT_SOFTWARE_VERSION                        19
+#define LWM2M_DEVICE_OBJECT_BATTERY_STATUS                          20
+#define LWM2M_DEVICE_OBJECT_MEMORY_TOTAL                            21
+
+/* Read-only Device resources, kept in read-only memory and shared by all clients */
+#ifndef LWM2M_DEVICE_MANUFACTURER
+#define LWM2M_DEVICE_MANUFACTURER                   ""
+#endif
+#ifndef LWM2M_DEVICE_MODEL_NUMBER
+#define LWM2M_DEVICE_MODEL_NUMBER                   ""
+#endif
+#ifndef LWM2M_DEVICE_SERIAL_NUMBER
+#define LWM2M_DEVICE_SERIAL_NUMBER                  ""
+#endif
+#ifndef LWM2M_DEVICE_FIRMWARE_VERSION
+#define LWM2M_DEVICE_FIRMWARE_VERSION               ""
+#endif
+#ifndef LWM2M_DEVICE_TYPE
+#define LWM2M_DEVICE_TYPE                           ""
+#endif
+#ifndef LWM2M_DEVICE_HARDWARE_VERSION
+#define LWM2M_DEVICE_HARDWARE_VERSION               ""
+#endif
+#ifndef LWM2M_DEVICE_SOFTWARE_VERSION
+#define LWM2M_DEVICE_SOFTWARE_VERSION               VERSION
+#endif
+
+/*
+ * Time in ms for which a value sampled by a Device resource provider is served without asking the provider again.
+ * Current Time is sampled on every read.
+ */
+#ifndef LWM2M_DEVICE_CACHE_TTL
+#define LWM2M_DEVICE_CACHE_TTL                      1000
+#endif
+
+/* Entry of /sys/class/power_supply read by the default Battery Level and Power Source Voltage providers on Linux */
+#ifndef LWM2M_DEVICE_POWER_SUPPLY
+#define LWM2M_DEVICE_POWER_SUPPLY                   "BAT0"
+#endif
+
+/* Number of distinct error codes kept by the Error Code resource, the oldest is dropped when a new one is pushed */
+#ifndef LWM2M_DEVICE_ERROR_CODES
+#define LWM2M_DEVICE_ERROR_CODES                    8
+#endif
+
+/* Power Source Voltage of a power source sampled from the provider instead of set by DeviceObject_SetPowerSource */
+#define LWM2M_DEVICE_SAMPLED_VOLTAGE                (-1)
+
+/***************************************************************************************************
+ * Typedefs
+ **************************************************************************************************/
+
+/**
+ * Source of a Device resource sampled when it is read, see DeviceObject_SetProvider.
+ * @param resourceID Resource being read
+ * @param resourceInstanceID Instance of a multiple instance resource, 0 otherwise
+ * @param value Receives current value of the resource
+ * @return AwaError_Success if value was set, otherwise the last sampled value is read.
+ */
+typedef AwaError (*DeviceObjectProvider)(AwaResourceID resourceID, AwaResourceInstanceID resourceInstanceID, AwaInteger *value);
+
+typedef struct
+{
+    AwaInteger Type;                /* Available Power Sources value: 0 DC, 1 internal battery, 2 external battery, 4 PoE, 5 USB, 6 AC, 7 solar */
+    AwaInteger Voltage;             /* Power Source Voltage in mV, or LWM2M_DEVICE_SAMPLED_VOLTAGE */
+    AwaInteger Current;             /* Power Source Current in mA */
+} DeviceObjectPowerSource;
+
+/***************************************************************************************************
+ * Functions
+ **************************************************************************************************/
+
 int DefineDeviceObject(AwaStaticClient *awaClient);
 
+/**
+ * @brief Replaces the source of a Device resource sampled on read, for all clients. By default Memory Free and Memory
+ *  Total come from sysinfo, Current Time from CLOCK_REALTIME, Battery Level and Power Source Voltage from
+ *  LWM2M_DEVICE_POWER_SUPPLY. Cached values of the resource are dropped.
+ * @param resourceID One of LWM2M_DEVICE_OBJECT_MEMORY_FREE, LWM2M_DEVICE_OBJECT_MEMORY_TOTAL, LWM2M_DEVICE_OBJECT_CURRENT_TIME,
+ *  LWM2M_DEVICE_OBJECT_BATTERY_LEVEL or LWM2M_DEVICE_OBJECT_POWER_SOURCE_VOLTAGE
+ * @param provider Function sampling the resource, NULL restores the default
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError DeviceObject_SetProvider(AwaResourceID resourceID, DeviceObjectProvider provider);
+
+/**
+ * @brief Replaces all power sources of the Available Power Sources, Power Source Voltage and Power Source Current
+ *  resources, instance i describing sources[i]. Changed resources are notified once. The resources are created with the
+ *  first power source and are not deleted when all power sources are removed.
+ * @param awaClient Reference to AWA client handle
+ * @param sources Power sources, may be NULL if count is 0
+ * @param count Number of power sources, at most LWM2M_DEVICE_OBJECT_POWER_SOURCES_COUNT
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError DeviceObject_SetPowerSources(AwaStaticClient *awaClient, const DeviceObjectPowerSource *sources, size_t count);
+
+/**
+ * @brief Sets or appends one power source, see DeviceObject_SetPowerSources.
+ * @param awaClient Reference to AWA client handle
+ * @param index Instance of the power source, at most the current number of power sources
+ * @param type Available Power Sources value
+ * @param voltage Power Source Voltage in mV, or LWM2M_DEVICE_SAMPLED_VOLTAGE
+ * @param current Power Source Current in mA
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError DeviceObject_SetPowerSource(AwaStaticClient *awaClient, AwaResourceInstanceID index, AwaInteger type, AwaInteger voltage,
+    AwaInteger current);
+
+/**
+ * @brief Adds error codes to the Error Code resource. Codes already present and 0 (no error) are skipped, and the oldest
+ *  codes are dropped once LWM2M_DEVICE_ERROR_CODES are kept. The resource is notified once if any code was added. Reset
+ *  Error Code clears them.
+ * @param awaClient Reference to AWA client handle
+ * @param errorCodes Error codes in the order they occurred
+ * @param count Number of errorCodes
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError DeviceObject_PushErrorCodes(AwaStaticClient *awaClient, const AwaInteger *errorCodes, size_t count);
+
+/**
+ * @brief Adds one error code to the Error Code resource, see DeviceObject_PushErrorCodes.
+ * @param awaClient Reference to AWA client handle
+ * @param errorCode Error code
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError DeviceObject_PushErrorCode(AwaStaticClient *awaClient, AwaInteger errorCode);
+
 #endif /* LIBOBJECTS_LWM2M_CLIENT_DEVICE_OBJECT_H_ */
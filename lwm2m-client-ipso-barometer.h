@@ -51,13 +51,22 @@
 #define IPSO_BAROMETER_MAX_RANGE_VALUE                    5604
 #define IPSO_BAROMETER_RESET_MIN_AND_MAX_MEASURED_VALUES  5605
 
+/* Number of Barometer object instances, instance IDs are 0 .. BAROMETER_SENSORS - 1 */
+#ifndef BAROMETER_SENSORS
+#define BAROMETER_SENSORS                                 1
+#endif
+
+/* Units per AwaFloat unit when stored with IPSO_SENSOR_FIXED_POINT, i.e. tenths of a Pascal */
+#ifndef BAROMETER_FIXED_SCALE
+#define BAROMETER_FIXED_SCALE                             10
+#endif
 
 /***************************************************************************************************
  * Functions
  **************************************************************************************************/
 
 /**
- * @brief Define single IPSO Barometer object (with ID 3315) and all resources bound to it. It also takes min and max measurable air pressures as a parameters.
+ * @brief Define IPSO Barometer object (with ID 3315), all resources bound to it and BAROMETER_SENSORS instances of it. It also takes min and max measurable air pressures as a parameters.
  *  Range defined in this way is hardware specific and should be choosen from tech specification of used device.
  * @param awaClient Reference to AWA client handle
  * @param minRange Minimal air pressure which can be measured and represented by this object
@@ -74,4 +83,24 @@ AwaError BarometerObject_DefineObjectsAndResources(AwaStaticClient *awaClient, A
  */
 AwaError BarometerObject_SetPressure(AwaStaticClient *awaClient, AwaFloat pressure);
 
+/**
+ * @brief Updates current value of air pressure for one object instance. Call to this method updates also Min/Max measured values
+ *  of that instance.
+ * @param awaClient Reference to AWA client handle
+ * @param objectInstanceID ID of the object instance, between 0 and BAROMETER_SENSORS - 1
+ * @param pressure New value for air pressure resource (Sensor value)
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError BarometerObject_SetPressureInstance(AwaStaticClient *awaClient, AwaObjectInstanceID objectInstanceID, AwaFloat pressure);
+
+/**
+ * @brief Updates current value of air pressure from a block of samples, e.g. one DMA transfer. The last sample becomes the current
+ *  value, Min/Max measured values cover the whole block and each changed resource is notified once.
+ * @param awaClient Reference to AWA client handle
+ * @param samples Air pressure samples in the order they were taken
+ * @param count Number of samples, at least one
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError BarometerObject_SetPressureBatch(AwaStaticClient *awaClient, const AwaFloat *samples, size_t count);
+
 #endif /* LWM2M_CLIENT_IPSO_BAROMETER_H_ */
@@ -52,12 +52,22 @@
 #define IPSO_CONCENTRATION_RESET_MIN_AND_MAX_MEASURED_VALUES  5605
 #define IPSO_CONCENTRATION_APPLICATION_TYPE                   5750
 
+/* Number of Concentration object instances, instance IDs are 0 .. CONCENTRATION_SENSORS - 1 */
+#ifndef CONCENTRATION_SENSORS
+#define CONCENTRATION_SENSORS                                 1
+#endif
+
+/* Units per AwaFloat unit when stored with IPSO_SENSOR_FIXED_POINT, i.e. tenths of a ppm */
+#ifndef CONCENTRATION_FIXED_SCALE
+#define CONCENTRATION_FIXED_SCALE                             10
+#endif
+
 /***************************************************************************************************
  * Functions
  **************************************************************************************************/
 
 /**
- * @brief Define single IPSO Temperature object (with ID 3325) and all resources bound to it. It also takes min and max measurable concentrations as a parameters.
+ * @brief Define IPSO Concentration object (with ID 3325), all resources bound to it and CONCENTRATION_SENSORS instances of it. It also takes min and max measurable concentrations as a parameters.
  *  Range defined in this way is hardware specific and should be choosen from tech specification of used device.
  * @param awaClient Reference to AWA client handle
  * @param minRange Minimal concentration which can be measured and represented by this object
@@ -75,4 +85,24 @@ AwaError ConcentrationObject_DefineObjectsAndResources(AwaStaticClient *awaClien
  */
 AwaError ConcentrationObject_SetConcentration(AwaStaticClient *awaClient, AwaFloat concentration);
 
+/**
+ * @brief Updates current value of concentration for one object instance. Call to this method updates also Min/Max measured values
+ *  of that instance.
+ * @param awaClient Reference to AWA client handle
+ * @param objectInstanceID ID of the object instance, between 0 and CONCENTRATION_SENSORS - 1
+ * @param concentration New value for concentration resource (Sensor value)
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError ConcentrationObject_SetConcentrationInstance(AwaStaticClient *awaClient, AwaObjectInstanceID objectInstanceID, AwaFloat concentration);
+
+/**
+ * @brief Updates current value of concentration from a block of samples, e.g. one DMA transfer. The last sample becomes the current
+ *  value, Min/Max measured values cover the whole block and each changed resource is notified once.
+ * @param awaClient Reference to AWA client handle
+ * @param samples Concentration samples in the order they were taken
+ * @param count Number of samples, at least one
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError ConcentrationObject_SetConcentrationBatch(AwaStaticClient *awaClient, const AwaFloat *samples, size_t count);
+
 #endif /* LWM2M_CLIENT_IPSO_CONCENTRATION_H_ */
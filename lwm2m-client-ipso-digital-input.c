@@ -43,178 +43,152 @@
 #include <string.h>
 #include <awa/static.h>
 #include "lwm2m-client-ipso-digital-input.h"
+#include "lwm2m-client-libobjects-private.h"
 
 /***************************************************************************************************
- * Typedefs
+ * Definitions
  **************************************************************************************************/
 
-typedef struct
-{
-    AwaBoolean State;
-    AwaInteger Counter;
-    AwaBoolean Polarity;
-    AwaTime DebouncePeriod;
-    AwaInteger EdgeSelection;
-    char ApplicationType[128];
-    char SensorType[128];
-} IPSODigitalInput;
+/* Bits of IPSODigitalInput.Dirty, indices to DigitalInputDirtyResources */
+#define DIGITAL_INPUT_DIRTY_COUNTER             (1 << 0)
+#define DIGITAL_INPUT_DIRTY_STATE               (1 << 1)
 
 /***************************************************************************************************
  * Globals
  **************************************************************************************************/
 
-static IPSODigitalInput digitalInputs[DIGITAL_INPUTS];
+static const AwaResourceID DigitalInputDirtyResources[] = {
+    IPSO_DIGITAL_INPUT_COUNTER,
+    IPSO_DIGITAL_INPUT_STATE,
+};
 
 /***************************************************************************************************
  * Implementation
  **************************************************************************************************/
 
+#if LIBOBJECTS_DEFERRED_NOTIFY || (LIBOBJECTS_RING_SIZE > 0)
+static void DigitalInput_MarkDirty(LibObjectsContext *context, AwaObjectInstanceID objectInstanceID, uint8_t dirty)
+{
+    LIBOBJECTS_SET_BITS(&context->DigitalInputs[objectInstanceID].Dirty, dirty);
+    LIBOBJECTS_SET_BITS(&context->DirtyObjects, LIBOBJECTS_DIRTY_DIGITAL_INPUTS);
+}
+#endif
+
+/*
+ * Notifies resources changed by an update now, or marks them dirty for LibObjects_Flush.
+ */
+static void DigitalInput_Changed(AwaStaticClient *awaClient, AwaObjectInstanceID objectInstanceID, uint8_t dirty)
+{
+#if LIBOBJECTS_DEFERRED_NOTIFY
+    DigitalInput_MarkDirty(LibObjects_GetContext(awaClient), objectInstanceID, dirty);
+#else
+    LibObjects_NotifyDirty(awaClient, IPSO_DIGITAL_INPUT_OBJECT, objectInstanceID, dirty, DigitalInputDirtyResources);
+#endif
+}
+
+static AwaResult DigitalInput_ResetCounter(AwaStaticClient *awaClient, AwaOperation operation, AwaObjectInstanceID objectInstanceID,
+    void *instance, const LibObjectsResource *resource)
+{
+    IPSODigitalInput *digitalInput = instance;
+    LibObjectsCounter_Reset(&digitalInput->Counts);
+    digitalInput->Counter = 0;
+    DigitalInput_Changed(awaClient, objectInstanceID, DIGITAL_INPUT_DIRTY_COUNTER);
+    return AwaResult_Success;
+}
+
+/*
+ * Keeps State in line with a new Polarity.
+ */
+static AwaResult DigitalInput_PolarityChanged(AwaStaticClient *awaClient, AwaOperation operation, AwaObjectInstanceID objectInstanceID,
+    void *instance, const LibObjectsResource *resource)
+{
+    IPSODigitalInput *digitalInput = instance;
+    if ((operation == AwaOperation_Write) && (digitalInput->Polarity != digitalInput->Inverted))
+    {
+        digitalInput->Inverted = digitalInput->Polarity;
+        digitalInput->State = !digitalInput->State;
+        digitalInput->Pending = false;
+        LibObjectsTimer_Cancel(LibObjects_GetContext(awaClient), &digitalInput->DebounceTimer);
+        DigitalInput_Changed(awaClient, objectInstanceID, DIGITAL_INPUT_DIRTY_STATE);
+    }
+    return AwaResult_Success;
+}
+
+/*
+ * Takes the value of Counts being read, increments may be coming from several threads.
+ */
+static AwaResult DigitalInput_ReadCounter(AwaStaticClient *awaClient, AwaOperation operation, AwaObjectInstanceID objectInstanceID,
+    void *instance, const LibObjectsResource *resource)
+{
+    IPSODigitalInput *digitalInput = instance;
+    digitalInput->Counter = LibObjectsCounter_Read(&digitalInput->Counts);
+    return AwaResult_Success;
+}
+
+static const LibObjectsResource DigitalInputResources[] = {
+    LIBOBJECTS_RESOURCE(IPSO_DIGITAL_INPUT_STATE, "State", AwaResourceType_Boolean, true, AwaResourceOperations_ReadOnly,
+        IPSODigitalInput, State, NULL),
+    LIBOBJECTS_RESOURCE(IPSO_DIGITAL_INPUT_COUNTER, "Counter", AwaResourceType_Integer, false, AwaResourceOperations_ReadOnly,
+        IPSODigitalInput, Counter, DigitalInput_ReadCounter),
+    LIBOBJECTS_RESOURCE(IPSO_DIGITAL_INPUT_POLARITY, "Polarity", AwaResourceType_Boolean, false, AwaResourceOperations_ReadWrite,
+        IPSODigitalInput, Polarity, DigitalInput_PolarityChanged),
+    LIBOBJECTS_RESOURCE(IPSO_DIGITAL_INPUT_DEBOUNCE_PERIOD, "DebouncePeriod", AwaResourceType_Time, false, AwaResourceOperations_ReadWrite,
+        IPSODigitalInput, DebouncePeriod, NULL),
+    LIBOBJECTS_RESOURCE(IPSO_DIGITAL_INPUT_EDGE_SELECTION, "EdgeSelection", AwaResourceType_Integer, false, AwaResourceOperations_ReadWrite,
+        IPSODigitalInput, EdgeSelection, NULL),
+    LIBOBJECTS_POOLED_RESOURCE(IPSO_APPLICATION_TYPE, "ApplicationType", false, LIBOBJECTS_STRING_DIGITAL_INPUT_APPLICATION_TYPE),
+    LIBOBJECTS_POOLED_RESOURCE(IPSO_SENSOR_TYPE, "SensorType", false, LIBOBJECTS_STRING_DIGITAL_INPUT_SENSOR_TYPE),
+    LIBOBJECTS_EXECUTE_RESOURCE(IPSO_DIGITAL_INPUT_COUNTER_RESET, "CounterReset", DigitalInput_ResetCounter),
+};
+
+/* 1 + index to DigitalInputResources by resource ID - IPSO_DIGITAL_INPUT_STATE */
+static const uint8_t DigitalInputResourceIndex[IPSO_SENSOR_TYPE - IPSO_DIGITAL_INPUT_STATE + 1] = {
+    [IPSO_DIGITAL_INPUT_STATE - IPSO_DIGITAL_INPUT_STATE] = 1,
+    [IPSO_DIGITAL_INPUT_COUNTER - IPSO_DIGITAL_INPUT_STATE] = 2,
+    [IPSO_DIGITAL_INPUT_POLARITY - IPSO_DIGITAL_INPUT_STATE] = 3,
+    [IPSO_DIGITAL_INPUT_DEBOUNCE_PERIOD - IPSO_DIGITAL_INPUT_STATE] = 4,
+    [IPSO_DIGITAL_INPUT_EDGE_SELECTION - IPSO_DIGITAL_INPUT_STATE] = 5,
+    [IPSO_APPLICATION_TYPE - IPSO_DIGITAL_INPUT_STATE] = 6,
+    [IPSO_SENSOR_TYPE - IPSO_DIGITAL_INPUT_STATE] = 7,
+    [IPSO_DIGITAL_INPUT_COUNTER_RESET - IPSO_DIGITAL_INPUT_STATE] = 8,
+};
+
+static const LibObjectsResourceTable DigitalInputResourceTable = {
+    .ObjectID = IPSO_DIGITAL_INPUT_OBJECT,
+    .Base = IPSO_DIGITAL_INPUT_STATE,
+    .IndexSize = sizeof(DigitalInputResourceIndex),
+    .Index = DigitalInputResourceIndex,
+    .Resources = DigitalInputResources,
+    .Count = sizeof(DigitalInputResources) / sizeof(DigitalInputResources[0]),
+};
+
 static AwaResult digitalInputHandler(AwaStaticClient *client, AwaOperation operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID,
      AwaResourceID resourceID, AwaResourceInstanceID resourceInstanceID, void **dataPointer, size_t *dataSize, bool *changed)
 {
-    AwaResult result = AwaResult_InternalError;
+    LibObjectsContext *context = LibObjects_GetContext(client);
+    IPSODigitalInput *digitalInputs = context->DigitalInputs;
     if (!((objectID == IPSO_DIGITAL_INPUT_OBJECT) && (objectInstanceID >= 0) && (objectInstanceID < DIGITAL_INPUTS)))
     {
         printf("Incorrect object data\n");
-        return result;
+        return AwaResult_InternalError;
     }
 
     switch (operation)
     {
         case AwaOperation_DeleteObjectInstance:
-            result = AwaResult_SuccessDeleted;
+            LibObjectsTimer_Cancel(context, &digitalInputs[objectInstanceID].DebounceTimer);
             memset(&digitalInputs[objectInstanceID], 0, sizeof(digitalInputs[objectInstanceID]));
-            break;
+            return AwaResult_SuccessDeleted;
 
         case AwaOperation_CreateObjectInstance:
-            result = AwaResult_SuccessCreated;
+            LibObjectsTimer_Cancel(context, &digitalInputs[objectInstanceID].DebounceTimer);
             memset(&digitalInputs[objectInstanceID], 0, sizeof(digitalInputs[objectInstanceID]));
-            break;
-
-        case AwaOperation_CreateResource:
-            result = AwaResult_SuccessCreated;
-            break;
+            return AwaResult_SuccessCreated;
 
-        case AwaOperation_Execute:
-            if (resourceID == IPSO_DIGITAL_INPUT_COUNTER_RESET)
-            {
-                digitalInputs[objectInstanceID].Counter = 0;
-                AwaStaticClient_ResourceChanged(client, IPSO_DIGITAL_INPUT_OBJECT, objectInstanceID, IPSO_DIGITAL_INPUT_COUNTER);
-                result = AwaResult_Success;
-            }
-            else
-            {
-                printf("\n Invalid resource ID for DigitalInput execute operation");
-                result = AwaResult_InternalError;
-            }
-            break;
-
-        case AwaOperation_Read:
-            result = AwaResult_SuccessContent;
-            switch (resourceID)
-            {
-                case IPSO_DIGITAL_INPUT_STATE:
-                    *dataPointer = &digitalInputs[objectInstanceID].State;
-                    *dataSize = sizeof(digitalInputs[objectInstanceID].State) ;
-                    break;
-
-                case IPSO_DIGITAL_INPUT_COUNTER:
-                    *dataPointer = &digitalInputs[objectInstanceID].Counter;
-                    *dataSize = sizeof(digitalInputs[objectInstanceID].Counter) ;
-                    break;
-
-                case IPSO_DIGITAL_INPUT_POLARITY:
-                    *dataPointer = &digitalInputs[objectInstanceID].Polarity;
-                    *dataSize = sizeof(digitalInputs[objectInstanceID].Polarity) ;
-                    break;
-
-                case IPSO_DIGITAL_INPUT_DEBOUNCE_PERIOD:
-                    *dataPointer = &digitalInputs[objectInstanceID].DebouncePeriod;
-                    *dataSize = sizeof(digitalInputs[objectInstanceID].DebouncePeriod) ;
-                    break;
-
-                case IPSO_DIGITAL_INPUT_EDGE_SELECTION:
-                    *dataPointer = &digitalInputs[objectInstanceID].EdgeSelection;
-                    *dataSize = sizeof(digitalInputs[objectInstanceID].EdgeSelection) ;
-                    break;
-
-                case IPSO_APPLICATION_TYPE:
-                    *dataPointer = digitalInputs[objectInstanceID].ApplicationType;
-                    *dataSize = strlen(digitalInputs[objectInstanceID].ApplicationType) ;
-                    break;
-
-                case IPSO_SENSOR_TYPE:
-                    *dataPointer = digitalInputs[objectInstanceID].SensorType;
-                    *dataSize = strlen(digitalInputs[objectInstanceID].SensorType) ;
-                    break;
-
-                default:
-                    printf("\n Invalid resource ID for DigitalInput read operation");
-                    result = AwaResult_InternalError;
-                    break;
-            }
-            break;
-
-        case AwaOperation_Write:
-            *changed = true;
-            result = AwaResult_SuccessChanged;
-            switch (resourceID)
-            {
-                case IPSO_DIGITAL_INPUT_STATE:
-                    digitalInputs[objectInstanceID].State = *((AwaBoolean *)*dataPointer);
-                    break;
-
-                case IPSO_DIGITAL_INPUT_COUNTER:
-                    digitalInputs[objectInstanceID].Counter = *((AwaInteger *)*dataPointer);
-                    break;
-
-                case IPSO_DIGITAL_INPUT_POLARITY:
-                    digitalInputs[objectInstanceID].Polarity = *((AwaBoolean *)*dataPointer);
-                    break;
-
-                case IPSO_DIGITAL_INPUT_DEBOUNCE_PERIOD:
-                    digitalInputs[objectInstanceID].DebouncePeriod = *((AwaTime *)*dataPointer);
-                    break;
-
-                case IPSO_DIGITAL_INPUT_EDGE_SELECTION:
-                    digitalInputs[objectInstanceID].EdgeSelection = *((AwaInteger *)*dataPointer);
-                    break;
-
-                case IPSO_APPLICATION_TYPE:
-                    if(*dataSize < sizeof(digitalInputs[objectInstanceID].ApplicationType))
-                    {
-                        memcpy(digitalInputs[objectInstanceID].ApplicationType, *dataPointer, *dataSize);
-                        digitalInputs[objectInstanceID].ApplicationType[*dataSize] = '\0';
-                    }
-                    else
-                    {
-                        result = AwaResult_BadRequest;
-                    }
-                    break;
-
-                case IPSO_SENSOR_TYPE:
-                    if(*dataSize < sizeof(digitalInputs[objectInstanceID].SensorType))
-                    {
-                        memcpy(digitalInputs[objectInstanceID].SensorType, *dataPointer, *dataSize);
-                        digitalInputs[objectInstanceID].SensorType[*dataSize] = '\0';
-                    }
-                    else
-                    {
-                        result = AwaResult_BadRequest;
-                    }
-                    break;
-
-                default:
-                    printf("\n Invalid resource ID for DigitalInput write operation");
-                    result = AwaResult_InternalError;
-                    break;
-            }
-            break;
         default:
-            printf("DigitalInput - unknown operation\n");
-            break;
+            return LibObjects_HandleResource(client, &DigitalInputResourceTable, &digitalInputs[objectInstanceID], operation, objectInstanceID,
+                resourceID, dataPointer, dataSize, changed);
     }
-    return result;
 }
 
 int DefineDigitalInputObject(AwaStaticClient *awaClient)
@@ -230,93 +204,207 @@ int DefineDigitalInputObject(AwaStaticClient *awaClient)
         return 1;
     }
 
-    AwaStaticClient_DefineResource(awaClient, IPSO_DIGITAL_INPUT_OBJECT, IPSO_DIGITAL_INPUT_STATE, "State", AwaResourceType_Boolean, 1, 1,
-        AwaResourceOperations_ReadOnly);
-    error = AwaStaticClient_SetResourceOperationHandler(awaClient, IPSO_DIGITAL_INPUT_OBJECT, IPSO_DIGITAL_INPUT_STATE, digitalInputHandler);
-    if (error != AwaError_Success)
+    if (LibObjects_DefineResources(awaClient, &DigitalInputResourceTable, digitalInputHandler) != AwaError_Success)
     {
-        printf("Failed to define State resource\n");
         return 1;
     }
 
-    AwaStaticClient_DefineResource(awaClient, IPSO_DIGITAL_INPUT_OBJECT, IPSO_DIGITAL_INPUT_COUNTER, "Counter", AwaResourceType_Integer, 0, 1,
-        AwaResourceOperations_ReadOnly);
-    error = AwaStaticClient_SetResourceOperationHandler(awaClient, IPSO_DIGITAL_INPUT_OBJECT, IPSO_DIGITAL_INPUT_COUNTER, digitalInputHandler);
-    if (error != AwaError_Success)
+    for (i = 0; i < DIGITAL_INPUTS; i++)
     {
-        printf("Failed to define Counter resource\n");
-        return 1;
+        AwaStaticClient_CreateObjectInstance(awaClient, IPSO_DIGITAL_INPUT_OBJECT, i);
+        AwaStaticClient_CreateResource(awaClient, IPSO_DIGITAL_INPUT_OBJECT, i, IPSO_DIGITAL_INPUT_COUNTER);
     }
+    return 0;
+}
 
-    AwaStaticClient_DefineResource(awaClient, IPSO_DIGITAL_INPUT_OBJECT, IPSO_DIGITAL_INPUT_POLARITY, "Polarity", AwaResourceType_Boolean, 0, 1,
-        AwaResourceOperations_ReadWrite);
-    error = AwaStaticClient_SetResourceOperationHandler(awaClient, IPSO_DIGITAL_INPUT_OBJECT, IPSO_DIGITAL_INPUT_POLARITY, digitalInputHandler);
-    if (error != AwaError_Success)
+
+int DigitalInput_IncrementCounter(AwaStaticClient *awaClient, AwaObjectInstanceID objectInstanceID)
+{
+    return DigitalInput_AddCount(awaClient, objectInstanceID, 1);
+}
+
+int DigitalInput_AddCount(AwaStaticClient *awaClient, AwaObjectInstanceID objectInstanceID, AwaInteger count)
+{
+    if ((awaClient != NULL) && (objectInstanceID >= 0) && (objectInstanceID < DIGITAL_INPUTS) && (count >= 0))
+    {
+        IPSODigitalInput *digitalInputs = LibObjects_GetContext(awaClient)->DigitalInputs;
+        if (count > 0)
+        {
+            LibObjectsCounter_Add(&digitalInputs[objectInstanceID].Counts, count);
+            DigitalInput_Changed(awaClient, objectInstanceID, DIGITAL_INPUT_DIRTY_COUNTER);
+        }
+        return 0;
+    }
+    else
     {
-        printf("Failed to define Polarity resource\n");
+        printf("Invalid arguments passed to %s", __func__);
         return 1;
     }
+}
 
-    AwaStaticClient_DefineResource(awaClient, IPSO_DIGITAL_INPUT_OBJECT, IPSO_DIGITAL_INPUT_DEBOUNCE_PERIOD, "DebouncePeriod", AwaResourceType_Time, 0, 1,
-        AwaResourceOperations_ReadWrite);
-    error = AwaStaticClient_SetResourceOperationHandler(awaClient, IPSO_DIGITAL_INPUT_OBJECT, IPSO_DIGITAL_INPUT_DEBOUNCE_PERIOD, digitalInputHandler);
-    if (error != AwaError_Success)
+int DigitalInput_AddCounts(AwaStaticClient *awaClient, const AwaInteger counts[DIGITAL_INPUTS])
+{
+    IPSODigitalInput *digitalInputs;
+    int i;
+
+    if ((awaClient == NULL) || (counts == NULL))
     {
-        printf("Failed to define DebouncePeriod resource\n");
+        printf("Invalid arguments passed to %s", __func__);
         return 1;
     }
+    for (i = 0; i < DIGITAL_INPUTS; i++)
+    {
+        if (counts[i] < 0)
+        {
+            printf("Invalid arguments passed to %s", __func__);
+            return 1;
+        }
+    }
 
-    AwaStaticClient_DefineResource(awaClient, IPSO_DIGITAL_INPUT_OBJECT, IPSO_DIGITAL_INPUT_EDGE_SELECTION, "EdgeSelection", AwaResourceType_Integer, 0, 1,
-        AwaResourceOperations_ReadWrite);
-    error = AwaStaticClient_SetResourceOperationHandler(awaClient, IPSO_DIGITAL_INPUT_OBJECT, IPSO_DIGITAL_INPUT_EDGE_SELECTION, digitalInputHandler);
-    if (error != AwaError_Success)
+    digitalInputs = LibObjects_GetContext(awaClient)->DigitalInputs;
+    for (i = 0; i < DIGITAL_INPUTS; i++)
     {
-        printf("Failed to define EdgeSelection resource\n");
-        return 1;
+        if (counts[i] > 0)
+        {
+            LibObjectsCounter_Add(&digitalInputs[i].Counts, counts[i]);
+            DigitalInput_Changed(awaClient, i, DIGITAL_INPUT_DIRTY_COUNTER);
+        }
     }
+    return 0;
+}
 
-    AwaStaticClient_DefineResource(awaClient, IPSO_DIGITAL_INPUT_OBJECT, IPSO_APPLICATION_TYPE, "ApplicationType", AwaResourceType_String, 0, 1,
-        AwaResourceOperations_ReadOnly);
-    error = AwaStaticClient_SetResourceOperationHandler(awaClient, IPSO_DIGITAL_INPUT_OBJECT, IPSO_APPLICATION_TYPE, digitalInputHandler);
-    if (error != AwaError_Success)
+/*
+ * Makes the pending level the new State, returns DIGITAL_INPUT_DIRTY_* bits of the resources it changed.
+ */
+static uint8_t DigitalInput_Accept(IPSODigitalInput *digitalInput)
+{
+    bool state = !digitalInput->State;
+    uint8_t dirty = DIGITAL_INPUT_DIRTY_STATE;
+
+    digitalInput->Pending = false;
+    digitalInput->State = state;
+    switch (digitalInput->EdgeSelection)
     {
-        printf("Failed to define ApplicationType resource\n");
-        return 1;
+        case IPSO_DIGITAL_INPUT_EDGE_FALLING:
+            if (state)
+            {
+                return dirty;
+            }
+            break;
+
+        case IPSO_DIGITAL_INPUT_EDGE_BOTH:
+            break;
+
+        default:
+            if (!state)
+            {
+                return dirty;
+            }
+            break;
     }
+    LibObjectsCounter_Add(&digitalInput->Counts, 1);
+    return dirty | DIGITAL_INPUT_DIRTY_COUNTER;
+}
 
-    AwaStaticClient_DefineResource(awaClient, IPSO_DIGITAL_INPUT_OBJECT, IPSO_SENSOR_TYPE, "SensorType", AwaResourceType_String, 0, 1,
-        AwaResourceOperations_ReadOnly);
-    error = AwaStaticClient_SetResourceOperationHandler(awaClient, IPSO_DIGITAL_INPUT_OBJECT , IPSO_SENSOR_TYPE, digitalInputHandler);
-    if (error != AwaError_Success)
+/*
+ * No sample has bounced back during the debounce period.
+ */
+static void DigitalInput_DebounceExpired(AwaStaticClient *awaClient, LibObjectsContext *context, LibObjectsTimer *timer)
+{
+    IPSODigitalInput *digitalInput = LIBOBJECTS_CONTAINER_OF(timer, IPSODigitalInput, DebounceTimer);
+    if (digitalInput->Pending)
     {
-        printf("Failed to define SensorType resource\n");
-        return 1;
+        DigitalInput_Changed(awaClient, digitalInput - context->DigitalInputs, DigitalInput_Accept(digitalInput));
     }
+}
 
-    AwaStaticClient_DefineResource(awaClient, IPSO_DIGITAL_INPUT_OBJECT, IPSO_DIGITAL_INPUT_COUNTER_RESET, "CounterReset", AwaResourceType_Opaque, 0, 1,
-        AwaResourceOperations_Execute);
-    error = AwaStaticClient_SetResourceOperationHandler(awaClient, IPSO_DIGITAL_INPUT_OBJECT , IPSO_DIGITAL_INPUT_COUNTER_RESET, digitalInputHandler);
-    if (error != AwaError_Success)
+/*
+ * Applies a sample of the line, returns DIGITAL_INPUT_DIRTY_* bits of the resources changed by a debounced edge.
+ * A pending level is also accepted by the debounce timer if no other sample comes.
+ */
+static uint8_t DigitalInput_Debounce(LibObjectsContext *context, IPSODigitalInput *digitalInput, bool level, LibObjectsTime timestamp)
+{
+    if ((level != digitalInput->Polarity) == digitalInput->State)
+    {
+        if (digitalInput->Pending)
+        {
+            digitalInput->Pending = false;
+            LibObjectsTimer_Cancel(context, &digitalInput->DebounceTimer);
+        }
+        return 0;
+    }
+    if (!digitalInput->Pending)
     {
-        printf("Failed to define CounterReset resource\n");
+        digitalInput->Pending = true;
+        digitalInput->PendingTime = timestamp;
+        if (digitalInput->DebouncePeriod > 0)
+        {
+            LibObjectsTimer_Schedule(context, &digitalInput->DebounceTimer, timestamp + digitalInput->DebouncePeriod,
+                DigitalInput_DebounceExpired);
+        }
+    }
+    if ((digitalInput->DebouncePeriod > 0) && (timestamp - digitalInput->PendingTime < (LibObjectsTime)digitalInput->DebouncePeriod))
+    {
+        return 0;
+    }
+    LibObjectsTimer_Cancel(context, &digitalInput->DebounceTimer);
+    return DigitalInput_Accept(digitalInput);
+}
+
+int DigitalInput_FeedSample(AwaStaticClient *awaClient, AwaObjectInstanceID objectInstanceID, bool level, LibObjectsTime timestamp)
+{
+    return DigitalInput_FeedSamples(awaClient, objectInstanceID, (const uint8_t[]){ level }, 1, timestamp, 0);
+}
+
+int DigitalInput_FeedSamples(AwaStaticClient *awaClient, AwaObjectInstanceID objectInstanceID, const uint8_t *levels, size_t count,
+    LibObjectsTime timestamp, LibObjectsTime interval)
+{
+    LibObjectsContext *context;
+    IPSODigitalInput *digitalInput;
+    uint8_t dirty = 0;
+    size_t i = 0;
+
+    if ((awaClient == NULL) || (objectInstanceID < 0) || (objectInstanceID >= DIGITAL_INPUTS) || ((levels == NULL) && (count > 0)))
+    {
+        printf("Invalid arguments passed to %s", __func__);
         return 1;
     }
 
-    for (i = 0; i < DIGITAL_INPUTS; i++)
+    context = LibObjects_GetContext(awaClient);
+    digitalInput = &context->DigitalInputs[objectInstanceID];
+    while (i < count)
     {
-        AwaStaticClient_CreateObjectInstance(awaClient, IPSO_DIGITAL_INPUT_OBJECT, i);
-        AwaStaticClient_CreateResource(awaClient, IPSO_DIGITAL_INPUT_OBJECT, i, IPSO_DIGITAL_INPUT_COUNTER);
+        /* A whole byte at the level of State changes nothing */
+        if (((i & 7) == 0) && (count - i >= 8) && !digitalInput->Pending &&
+            (levels[i >> 3] == ((digitalInput->State != digitalInput->Polarity) ? 0xFF : 0x00)))
+        {
+            i += 8;
+            continue;
+        }
+        dirty |= DigitalInput_Debounce(context, digitalInput, (levels[i >> 3] >> (i & 7)) & 1, timestamp + i * interval);
+        i++;
+    }
+    if (dirty != 0)
+    {
+        DigitalInput_Changed(awaClient, objectInstanceID, dirty);
     }
     return 0;
 }
 
+#if LIBOBJECTS_RING_SIZE > 0
 
-int DigitalInput_IncrementCounter(AwaStaticClient *awaClient, AwaObjectInstanceID objectInstanceID)
+int DigitalInput_PushIncrement(AwaStaticClient *awaClient, AwaObjectInstanceID objectInstanceID)
 {
     if ((awaClient != NULL) && (objectInstanceID >= 0) && (objectInstanceID < DIGITAL_INPUTS))
     {
-        digitalInputs[objectInstanceID].Counter += 1;
-        AwaStaticClient_ResourceChanged(awaClient, IPSO_DIGITAL_INPUT_OBJECT, objectInstanceID, IPSO_DIGITAL_INPUT_COUNTER);
+        LibObjectsContext *context = LibObjects_GetContext(awaClient);
+        uint32_t head;
+        if (!LibObjectsRing_Reserve(&context->DigitalInputRing, &head))
+        {
+            return 1;
+        }
+        context->DigitalInputSamples[LIBOBJECTS_RING_SLOT(head)] = objectInstanceID;
+        LibObjectsRing_Commit(&context->DigitalInputRing, head);
         return 0;
     }
     else
@@ -325,3 +413,29 @@ int DigitalInput_IncrementCounter(AwaStaticClient *awaClient, AwaObjectInstanceI
         return 1;
     }
 }
+
+void DigitalInput_Drain(AwaStaticClient *awaClient, LibObjectsContext *context)
+{
+    uint32_t tail;
+    uint32_t head = LibObjectsRing_Peek(&context->DigitalInputRing, &tail);
+
+    for (; tail != head; tail++)
+    {
+        AwaObjectInstanceID objectInstanceID = context->DigitalInputSamples[LIBOBJECTS_RING_SLOT(tail)];
+        LibObjectsCounter_Add(&context->DigitalInputs[objectInstanceID].Counts, 1);
+        DigitalInput_MarkDirty(context, objectInstanceID, DIGITAL_INPUT_DIRTY_COUNTER);
+    }
+    LibObjectsRing_Release(&context->DigitalInputRing, tail);
+}
+
+#endif /* LIBOBJECTS_RING_SIZE > 0 */
+
+void DigitalInput_Flush(AwaStaticClient *awaClient, LibObjectsContext *context)
+{
+    int i;
+    for (i = 0; i < DIGITAL_INPUTS; i++)
+    {
+        LibObjects_NotifyDirty(awaClient, IPSO_DIGITAL_INPUT_OBJECT, i, LIBOBJECTS_TAKE_BITS(&context->DigitalInputs[i].Dirty),
+            DigitalInputDirtyResources);
+    }
+}
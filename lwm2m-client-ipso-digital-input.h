@@ -37,6 +37,7 @@
 #define LWM2M_CLIENT_IPSO_DIGITAL_INPUT_H_
 
 #include "awa/static.h"
+#include "lwm2m-client-libobjects.h"
 
 /***************************************************************************************************
  * Macros
@@ -54,11 +55,89 @@
 
 #define DIGITAL_INPUTS                          2
 
+/* Values of Edge Selection, edges increasing Counter */
+#define IPSO_DIGITAL_INPUT_EDGE_FALLING         1
+#define IPSO_DIGITAL_INPUT_EDGE_RISING          2
+#define IPSO_DIGITAL_INPUT_EDGE_BOTH            3
+
+/* Read-only Application Type and Sensor Type of all digital inputs */
+#ifndef DIGITAL_INPUT_APPLICATION_TYPE
+#define DIGITAL_INPUT_APPLICATION_TYPE          ""
+#endif
+#ifndef DIGITAL_INPUT_SENSOR_TYPE
+#define DIGITAL_INPUT_SENSOR_TYPE               ""
+#endif
+
 /***************************************************************************************************
  * Functions
  **************************************************************************************************/
 
 int DefineDigitalInputObject(AwaStaticClient *awaClient);
+
+/**
+ * @brief Increases the digital input counter by one. With LIBOBJECTS_THREAD_SAFE it may be called from any number of
+ *  threads at once, no increment is lost.
+ * @param awaClient Reference to AWA client handle
+ * @param objectInstanceID Digital input instance
+ * @return 0 if the counter was increased, 1 on invalid arguments.
+ */
 int DigitalInput_IncrementCounter(AwaStaticClient *awaClient, AwaObjectInstanceID objectInstanceID);
 
+/**
+ * @brief Increases the digital input counter by a number of pulses counted by the application, with a single
+ *  notification. Thread safety is that of DigitalInput_IncrementCounter.
+ * @param awaClient Reference to AWA client handle
+ * @param objectInstanceID Digital input instance
+ * @param count Number of pulses, 0 changes nothing
+ * @return 0 if the counter was increased, 1 on invalid arguments.
+ */
+int DigitalInput_AddCount(AwaStaticClient *awaClient, AwaObjectInstanceID objectInstanceID, AwaInteger count);
+
+/**
+ * @brief Increases the counters of all digital inputs at once, see DigitalInput_AddCount. Each counter increased is
+ *  notified once.
+ * @param awaClient Reference to AWA client handle
+ * @param counts Number of pulses of each digital input instance
+ * @return 0 if the counters were increased, 1 on invalid arguments.
+ */
+int DigitalInput_AddCounts(AwaStaticClient *awaClient, const AwaInteger counts[DIGITAL_INPUTS]);
+
+/**
+ * @brief Feeds a sample of the digital input line. The level is inverted when Polarity is set, and a level differing from
+ *  State becomes the new State once it has been seen for Debounce Period ms without bouncing back, on a later sample or
+ *  on the LibObjects_Tick reaching the end of the period. Counter is increased on
+ *  the edges chosen by Edge Selection, rising edges unless it is IPSO_DIGITAL_INPUT_EDGE_FALLING or IPSO_DIGITAL_INPUT_EDGE_BOTH.
+ *  Only these debounced edges are notified. The debounce timer is run by LibObjects_Tick, so samples must be fed on the
+ *  thread running AwaStaticClient_Process.
+ * @param awaClient Reference to AWA client handle
+ * @param objectInstanceID Digital input instance
+ * @param level Level of the line
+ * @param timestamp Time of the sample in ms, on the clock passed to LibObjects_Tick
+ * @return 0 if the sample was applied, 1 on invalid arguments.
+ */
+int DigitalInput_FeedSample(AwaStaticClient *awaClient, AwaObjectInstanceID objectInstanceID, bool level, LibObjectsTime timestamp);
+
+/**
+ * @brief Feeds samples of the digital input line taken at a fixed interval, see DigitalInput_FeedSample. Edges of the
+ *  whole batch are notified once. Like it, must be called on the thread running AwaStaticClient_Process.
+ * @param awaClient Reference to AWA client handle
+ * @param objectInstanceID Digital input instance
+ * @param levels Levels of the line, sample i is bit i % 8 of levels[i / 8]
+ * @param count Number of samples
+ * @param timestamp Time of the first sample in ms
+ * @param interval Time between samples in ms
+ * @return 0 if the samples were applied, 1 on invalid arguments.
+ */
+int DigitalInput_FeedSamples(AwaStaticClient *awaClient, AwaObjectInstanceID objectInstanceID, const uint8_t *levels, size_t count,
+    LibObjectsTime timestamp, LibObjectsTime interval);
+
+#if LIBOBJECTS_RING_SIZE > 0
+/**
+ * @brief Queues increment of the digital input counter, applied by the next LibObjects_Drain. Safe to call from one
+ *  producer thread while the Awa thread is processing.
+ * @return 0 if the increment was queued, 1 on invalid arguments or full queue.
+ */
+int DigitalInput_PushIncrement(AwaStaticClient *awaClient, AwaObjectInstanceID objectInstanceID);
+#endif
+
 #endif /* LWM2M_CLIENT_IPSO_DIGITAL_INPUT_H_ */
@@ -52,12 +52,22 @@
 #define IPSO_DISTANCE_RESET_MIN_AND_MAX_MEASURED_VALUES  5605
 #define IPSO_DISTANCE_APPLICATION_TYPE                   5750
 
+/* Number of Distance object instances, instance IDs are 0 .. DISTANCE_SENSORS - 1 */
+#ifndef DISTANCE_SENSORS
+#define DISTANCE_SENSORS                                 1
+#endif
+
+/* Units per AwaFloat unit when stored with IPSO_SENSOR_FIXED_POINT, i.e. millimeters */
+#ifndef DISTANCE_FIXED_SCALE
+#define DISTANCE_FIXED_SCALE                             1000
+#endif
+
 /***************************************************************************************************
  * Functions
  **************************************************************************************************/
 
 /**
- * @brief Define single IPSO Temperature object (with ID 3330) and all resources bound to it. It also takes min and max measurable distances as a parameters.
+ * @brief Define IPSO Distance object (with ID 3330), all resources bound to it and DISTANCE_SENSORS instances of it. It also takes min and max measurable distances as a parameters.
  *  Range defined in this way is hardware specific and should be choosen from tech specification of used device.
  * @param awaClient Reference to AWA client handle
  * @param minRange Minimal distance which can be measured and represented by this object
@@ -75,4 +85,24 @@ AwaError DistanceObject_DefineObjectsAndResources(AwaStaticClient *awaClient, Aw
  */
 AwaError DistanceObject_SetDistance(AwaStaticClient *awaClient, AwaFloat distance);
 
+/**
+ * @brief Updates current value of distance for one object instance. Call to this method updates also Min/Max measured values
+ *  of that instance.
+ * @param awaClient Reference to AWA client handle
+ * @param objectInstanceID ID of the object instance, between 0 and DISTANCE_SENSORS - 1
+ * @param distance New value for distance resource (Sensor value)
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError DistanceObject_SetDistanceInstance(AwaStaticClient *awaClient, AwaObjectInstanceID objectInstanceID, AwaFloat distance);
+
+/**
+ * @brief Updates current value of distance from a block of samples, e.g. one DMA transfer. The last sample becomes the current
+ *  value, Min/Max measured values cover the whole block and each changed resource is notified once.
+ * @param awaClient Reference to AWA client handle
+ * @param samples Distance samples in the order they were taken
+ * @param count Number of samples, at least one
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError DistanceObject_SetDistanceBatch(AwaStaticClient *awaClient, const AwaFloat *samples, size_t count);
+
 #endif /* LWM2M_CLIENT_IPSO_DISTANCE_H_ */
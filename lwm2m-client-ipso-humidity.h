@@ -51,13 +51,22 @@
 #define IPSO_HUMIDITY_MAX_RANGE_VALUE                    5604
 #define IPSO_HUMIDITY_RESET_MIN_AND_MAX_MEASURED_VALUES  5605
 
+/* Number of Humidity object instances, instance IDs are 0 .. HUMIDITY_SENSORS - 1 */
+#ifndef HUMIDITY_SENSORS
+#define HUMIDITY_SENSORS                                 1
+#endif
+
+/* Units per AwaFloat unit when stored with IPSO_SENSOR_FIXED_POINT, i.e. hundredths of a percent */
+#ifndef HUMIDITY_FIXED_SCALE
+#define HUMIDITY_FIXED_SCALE                             100
+#endif
 
 /***************************************************************************************************
  * Functions
  **************************************************************************************************/
 
 /**
- * @brief Define single IPSO Humidity object (with ID 3004) and all resources bound to it. It also takes min and max measurable humidities as a parameters.
+ * @brief Define IPSO Humidity object (with ID 3004), all resources bound to it and HUMIDITY_SENSORS instances of it. It also takes min and max measurable humidities as a parameters.
  *  Range defined in this way is hardware specific and should be choosen from tech specification of used device.
  * @param awaClient Reference to AWA client handle
  * @param minRange Minimal humidity which can be measured and represented by this object
@@ -74,4 +83,24 @@ AwaError HumidityObject_DefineObjectsAndResources(AwaStaticClient *awaClient, Aw
  */
 AwaError HumidityObject_SetHumidity(AwaStaticClient *awaClient, AwaFloat humidity);
 
+/**
+ * @brief Updates current value of humidity for one object instance. Call to this method updates also Min/Max measured values
+ *  of that instance.
+ * @param awaClient Reference to AWA client handle
+ * @param objectInstanceID ID of the object instance, between 0 and HUMIDITY_SENSORS - 1
+ * @param humidity New value for humidity resource (Sensor value)
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError HumidityObject_SetHumidityInstance(AwaStaticClient *awaClient, AwaObjectInstanceID objectInstanceID, AwaFloat humidity);
+
+/**
+ * @brief Updates current value of humidity from a block of samples, e.g. one DMA transfer. The last sample becomes the current
+ *  value, Min/Max measured values cover the whole block and each changed resource is notified once.
+ * @param awaClient Reference to AWA client handle
+ * @param samples Humidity samples in the order they were taken
+ * @param count Number of samples, at least one
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError HumidityObject_SetHumidityBatch(AwaStaticClient *awaClient, const AwaFloat *samples, size_t count);
+
 #endif /* LWM2M_CLIENT_IPSO_humidITY_H_ */
@@ -44,6 +44,7 @@
 
 #include "awa/static.h"
 #include "lwm2m-client-ipso-light-control.h"
+#include "lwm2m-client-libobjects-private.h"
 
 /***************************************************************************************************
  * Definitions
@@ -58,177 +59,129 @@
 #define IPSO_LIGHT_CONTROL_CUMULATIVE_ACTIVE_POWER       5805
 #define IPSO_LIGHT_CONTROL_POWER_FACTOR                  5820
 
-#define LIGHT_CONTROLS                                   2
-
 /***************************************************************************************************
- * Typedefs
+ * Implementation
  **************************************************************************************************/
 
-typedef struct
+/*
+ * Adds the time and energy of On/Off and Dimmer in effect since the last call to On Time and Cumulative Active Power,
+ * then takes the current On/Off and Dimmer as in effect from now on.
+ */
+static void LightControl_Account(IPSOLightControl *lightControl)
 {
-    AwaBoolean OnOff;
-    AwaInteger Dimmer;
-    char Colour[64];
-    char Units[64];
-    AwaInteger OnTime;
-    AwaFloat CumulativeActivePower;
-    AwaFloat PowerFactor;
-    LightControlCallBack callback;
-    void *context;
-} IPSOLightControl;
+    LibObjectsTime now = LibObjects_GetTime();
 
-/***************************************************************************************************
- * Globals
- **************************************************************************************************/
+    if (lightControl->AccountedOnOff && (now > lightControl->AccountedTime))
+    {
+        LibObjectsTime elapsed = now - lightControl->AccountedTime;
+        AwaInteger dimmer = lightControl->AccountedDimmer;
 
-static IPSOLightControl lightControls[LIGHT_CONTROLS];
+        dimmer = (dimmer < 0) ? 0 : ((dimmer > 100) ? 100 : dimmer);
+        lightControl->OnMilliseconds += elapsed;
+        /* W * ms to Wh */
+        lightControl->CumulativeActivePower += lightControl->RatedPower * dimmer / 100 * elapsed / 3600000.0;
+    }
+    lightControl->AccountedOnOff = lightControl->OnOff;
+    lightControl->AccountedDimmer = lightControl->Dimmer;
+    lightControl->AccountedTime = now;
+}
 
-/***************************************************************************************************
- * Implementation
- **************************************************************************************************/
+/*
+ * Brings On Time and Cumulative Active Power up to date when they are read, a written On Time restarts the count.
+ */
+static AwaResult LightControl_Accounted(AwaStaticClient *awaClient, AwaOperation operation, AwaObjectInstanceID objectInstanceID,
+    void *instance, const LibObjectsResource *resource)
+{
+    IPSOLightControl *lightControl = instance;
+    AwaInteger onTime = lightControl->OnTime;
+
+    LightControl_Account(lightControl);
+    if ((operation == AwaOperation_Write) && (resource->ResourceID == IPSO_LIGHT_CONTROL_ON_TIME))
+    {
+        lightControl->OnMilliseconds = (onTime > 0) ? (LibObjectsTime)onTime * 1000 : 0;
+    }
+    lightControl->OnTime = lightControl->OnMilliseconds / 1000;
+    return AwaResult_Success;
+}
+
+/*
+ * Passes the new state to the application after On/Off, Dimmer or Colour was written.
+ */
+static AwaResult LightControl_Changed(AwaStaticClient *awaClient, AwaOperation operation, AwaObjectInstanceID objectInstanceID,
+    void *instance, const LibObjectsResource *resource)
+{
+    IPSOLightControl *lightControl = instance;
+    if (operation == AwaOperation_Write)
+    {
+        LightControl_Account(lightControl);
+        if (lightControl->callback != NULL)
+        {
+            lightControl->callback(lightControl->context, lightControl->OnOff, lightControl->Dimmer, lightControl->Colour.Value);
+        }
+    }
+    return AwaResult_Success;
+}
+
+static const LibObjectsResource LightControlResources[] = {
+    LIBOBJECTS_RESOURCE(IPSO_LIGHT_CONTROL_ON_OFF, "On/Off", AwaResourceType_Boolean, true, AwaResourceOperations_ReadWrite,
+        IPSOLightControl, OnOff, LightControl_Changed),
+    LIBOBJECTS_RESOURCE(IPSO_LIGHT_CONTROL_DIMMER, "Dimmer", AwaResourceType_Integer, false, AwaResourceOperations_ReadWrite,
+        IPSOLightControl, Dimmer, LightControl_Changed),
+    LIBOBJECTS_STRING_RESOURCE(IPSO_LIGHT_CONTROL_COLOUR, "Colour", false, AwaResourceOperations_ReadWrite,
+        IPSOLightControl, Colour, LightControl_Changed),
+    LIBOBJECTS_POOLED_RESOURCE(IPSO_LIGHT_CONTROL_UNITS, "Units", true, LIBOBJECTS_STRING_LIGHT_CONTROL_UNITS),
+    LIBOBJECTS_RESOURCE(IPSO_LIGHT_CONTROL_ON_TIME, "OnTime", AwaResourceType_Integer, false, AwaResourceOperations_ReadWrite,
+        IPSOLightControl, OnTime, LightControl_Accounted),
+    LIBOBJECTS_RESOURCE(IPSO_LIGHT_CONTROL_CUMULATIVE_ACTIVE_POWER, "CumulativeActivePower", AwaResourceType_Float, false,
+        AwaResourceOperations_ReadOnly, IPSOLightControl, CumulativeActivePower, LightControl_Accounted),
+    LIBOBJECTS_RESOURCE(IPSO_LIGHT_CONTROL_POWER_FACTOR, "PowerFactor", AwaResourceType_Float, false, AwaResourceOperations_ReadOnly,
+        IPSOLightControl, PowerFactor, NULL),
+};
+
+/* 1 + index to LightControlResources by resource ID - IPSO_LIGHT_CONTROL_UNITS */
+static const uint8_t LightControlResourceIndex[IPSO_LIGHT_CONTROL_ON_TIME - IPSO_LIGHT_CONTROL_UNITS + 1] = {
+    [IPSO_LIGHT_CONTROL_ON_OFF - IPSO_LIGHT_CONTROL_UNITS] = 1,
+    [IPSO_LIGHT_CONTROL_DIMMER - IPSO_LIGHT_CONTROL_UNITS] = 2,
+    [IPSO_LIGHT_CONTROL_COLOUR - IPSO_LIGHT_CONTROL_UNITS] = 3,
+    [IPSO_LIGHT_CONTROL_UNITS - IPSO_LIGHT_CONTROL_UNITS] = 4,
+    [IPSO_LIGHT_CONTROL_ON_TIME - IPSO_LIGHT_CONTROL_UNITS] = 5,
+    [IPSO_LIGHT_CONTROL_CUMULATIVE_ACTIVE_POWER - IPSO_LIGHT_CONTROL_UNITS] = 6,
+    [IPSO_LIGHT_CONTROL_POWER_FACTOR - IPSO_LIGHT_CONTROL_UNITS] = 7,
+};
+
+static const LibObjectsResourceTable LightControlResourceTable = {
+    .ObjectID = IPSO_LIGHT_CONTROL_OBJECT,
+    .Base = IPSO_LIGHT_CONTROL_UNITS,
+    .IndexSize = sizeof(LightControlResourceIndex),
+    .Index = LightControlResourceIndex,
+    .Resources = LightControlResources,
+    .Count = sizeof(LightControlResources) / sizeof(LightControlResources[0]),
+};
 
 static AwaResult lightControlHandler(AwaStaticClient *client, AwaOperation operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID,
      AwaResourceID resourceID, AwaResourceInstanceID resourceInstanceID, void **dataPointer, size_t *dataSize, bool *changed)
 {
-    AwaResult result = AwaResult_InternalError;
-    bool callCallback = false;
+    IPSOLightControl *lightControls = LibObjects_GetContext(client)->LightControls;
     if (!((objectID == IPSO_LIGHT_CONTROL_OBJECT) && (objectInstanceID >= 0) && (objectInstanceID < LIGHT_CONTROLS)))
     {
         printf("Incorrect object data\n");
-        return result;
+        return AwaResult_InternalError;
     }
 
     switch (operation)
     {
         case AwaOperation_DeleteObjectInstance:
-            result = AwaResult_SuccessDeleted;
             memset(&lightControls[objectInstanceID], 0, sizeof(lightControls[objectInstanceID]));
-            break;
+            return AwaResult_SuccessDeleted;
 
         case AwaOperation_CreateObjectInstance:
-            result = AwaResult_SuccessCreated;
             memset(&lightControls[objectInstanceID], 0, sizeof(lightControls[objectInstanceID]));
-            break;
-
-        case AwaOperation_CreateResource:
-            result = AwaResult_SuccessCreated;
-            break;
-
-        case AwaOperation_Read:
-            result = AwaResult_SuccessContent;
-            switch (resourceID)
-            {
-                case IPSO_LIGHT_CONTROL_ON_OFF:
-                    *dataPointer = &lightControls[objectInstanceID].OnOff;
-                    *dataSize = sizeof(lightControls[objectInstanceID].OnOff) ;
-                    break;
-
-                case IPSO_LIGHT_CONTROL_DIMMER:
-                    *dataPointer = &lightControls[objectInstanceID].Dimmer;
-                    *dataSize = sizeof(lightControls[objectInstanceID].Dimmer) ;
-                    break;
-
-                case IPSO_LIGHT_CONTROL_COLOUR:
-                    *dataPointer = lightControls[objectInstanceID].Colour;
-                    *dataSize = sizeof(lightControls[objectInstanceID].Colour) ;
-                    break;
-
-                case IPSO_LIGHT_CONTROL_UNITS:
-                    *dataPointer = lightControls[objectInstanceID].Units;
-                    *dataSize = sizeof(lightControls[objectInstanceID].Units) ;
-                    break;
-
-                case IPSO_LIGHT_CONTROL_ON_TIME:
-                    *dataPointer = &lightControls[objectInstanceID].OnTime;
-                    *dataSize = sizeof(lightControls[objectInstanceID].OnTime) ;
-                    break;
-
-                case IPSO_LIGHT_CONTROL_CUMULATIVE_ACTIVE_POWER:
-                    *dataPointer = &lightControls[objectInstanceID].CumulativeActivePower;
-                    *dataSize = sizeof(lightControls[objectInstanceID].CumulativeActivePower) ;
-                    break;
-
-                case IPSO_LIGHT_CONTROL_POWER_FACTOR:
-                    *dataPointer = &lightControls[objectInstanceID].PowerFactor;
-                    *dataSize = sizeof(lightControls[objectInstanceID].PowerFactor) ;
-                    break;
-
-                default:
-                    printf("\n Invalid resource ID for LightControl read operation");
-                    result = AwaResult_InternalError;
-                    break;
-            }
-            break;
-
-        case AwaOperation_Write:
-            *changed = true;
-            result = AwaResult_SuccessChanged;
-            switch (resourceID)
-            {
-                case IPSO_LIGHT_CONTROL_ON_OFF:
-                    lightControls[objectInstanceID].OnOff = *((AwaBoolean *)*dataPointer);
-                    callCallback = true;
-                    break;
-
-                case IPSO_LIGHT_CONTROL_DIMMER:
-                    lightControls[objectInstanceID].Dimmer = *((AwaInteger *)*dataPointer);
-                    callCallback = true;
-                    break;
-
-                case IPSO_LIGHT_CONTROL_COLOUR:
-                    if(*dataSize < sizeof(lightControls[objectInstanceID].Colour))
-                    {
-                        memcpy(lightControls[objectInstanceID].Colour, *dataPointer, *dataSize);
-                        lightControls[objectInstanceID].Colour[*dataSize] = '\0';
-                        callCallback = true;
-                    }
-                    else
-                    {
-                        result = AwaResult_BadRequest;
-                    }
-                    break;
-
-                case IPSO_LIGHT_CONTROL_UNITS:
-                    if(*dataSize < sizeof(lightControls[objectInstanceID].Units))
-                    {
-                        memcpy(lightControls[objectInstanceID].Units, *dataPointer, *dataSize);
-                        lightControls[objectInstanceID].Units[*dataSize] = '\0';
-                    }
-                    else
-                    {
-                        result = AwaResult_BadRequest;
-                    }
-                    break;
-
-                case IPSO_LIGHT_CONTROL_ON_TIME:
-                    lightControls[objectInstanceID].OnTime = *((AwaInteger *)*dataPointer);
-                    break;
+            return AwaResult_SuccessCreated;
 
-                case IPSO_LIGHT_CONTROL_CUMULATIVE_ACTIVE_POWER:
-                    lightControls[objectInstanceID].CumulativeActivePower = *((AwaFloat *)*dataPointer);
-                    break;
-
-                case IPSO_LIGHT_CONTROL_POWER_FACTOR:
-                    lightControls[objectInstanceID].PowerFactor = *((AwaFloat *)*dataPointer);
-                    break;
-
-                default:
-                    printf("\n Invalid resource ID for LightControl write operation");
-                    result = AwaResult_InternalError;
-                    break;
-            }
-            if (lightControls[objectInstanceID].callback != NULL && callCallback)
-            {
-                lightControls[objectInstanceID].callback(lightControls[objectInstanceID].context,
-                    lightControls[objectInstanceID].OnOff, lightControls[objectInstanceID].Dimmer,
-                    lightControls[objectInstanceID].Colour);
-            }
-            break;
         default:
-            printf("LightControl - unknown operation\n");
-            break;
+            return LibObjects_HandleResource(client, &LightControlResourceTable, &lightControls[objectInstanceID], operation, objectInstanceID,
+                resourceID, dataPointer, dataSize, changed);
     }
-    return result;
 }
 
 int DefineLightControlObject(AwaStaticClient *awaClient)
@@ -242,75 +195,17 @@ int DefineLightControlObject(AwaStaticClient *awaClient)
         return -1;
     }
 
-    AwaStaticClient_DefineResource(awaClient, IPSO_LIGHT_CONTROL_OBJECT, IPSO_LIGHT_CONTROL_ON_OFF, "On/Off", AwaResourceType_Boolean, 1, 1,
-        AwaResourceOperations_ReadWrite);
-    error = AwaStaticClient_SetResourceOperationHandler(awaClient, IPSO_LIGHT_CONTROL_OBJECT, IPSO_LIGHT_CONTROL_ON_OFF, lightControlHandler);
-    if (error != AwaError_Success)
-    {
-        printf("Failed to define On/Off resource\n");
-        return -1;
-    }
-
-    AwaStaticClient_DefineResource(awaClient, IPSO_LIGHT_CONTROL_OBJECT, IPSO_LIGHT_CONTROL_DIMMER, "Dimmer", AwaResourceType_Integer, 0, 1,
-        AwaResourceOperations_ReadWrite);
-    error = AwaStaticClient_SetResourceOperationHandler(awaClient, IPSO_LIGHT_CONTROL_OBJECT, IPSO_LIGHT_CONTROL_DIMMER, lightControlHandler);
-    if (error != AwaError_Success)
-    {
-        printf("Failed to define Dimmer resource\n");
-        return -1;
-    }
-
-    AwaStaticClient_DefineResource(awaClient, IPSO_LIGHT_CONTROL_OBJECT, IPSO_LIGHT_CONTROL_COLOUR, "Colour", AwaResourceType_String, 0, 1,
-        AwaResourceOperations_ReadWrite);
-    error = AwaStaticClient_SetResourceOperationHandler(awaClient, IPSO_LIGHT_CONTROL_OBJECT, IPSO_LIGHT_CONTROL_COLOUR, lightControlHandler);
-    if (error != AwaError_Success)
-    {
-        printf("Failed to define Colour resource\n");
-        return -1;
-    }
-
-    AwaStaticClient_DefineResource(awaClient, IPSO_LIGHT_CONTROL_OBJECT, IPSO_LIGHT_CONTROL_UNITS, "Units", AwaResourceType_String, 1, 1,
-        AwaResourceOperations_ReadOnly);
-    error = AwaStaticClient_SetResourceOperationHandler(awaClient, IPSO_LIGHT_CONTROL_OBJECT, IPSO_LIGHT_CONTROL_UNITS, lightControlHandler);
-    if (error != AwaError_Success)
-    {
-        printf("Failed to define Units resource\n");
-        return -1;
-    }
-
-    AwaStaticClient_DefineResource(awaClient, IPSO_LIGHT_CONTROL_OBJECT, IPSO_LIGHT_CONTROL_ON_TIME, "OnTime", AwaResourceType_Integer, 0, 1,
-        AwaResourceOperations_ReadWrite);
-    error = AwaStaticClient_SetResourceOperationHandler(awaClient, IPSO_LIGHT_CONTROL_OBJECT, IPSO_LIGHT_CONTROL_ON_TIME, lightControlHandler);
-    if (error != AwaError_Success)
-    {
-        printf("Failed to define OnTime resource\n");
-        return -1;
-    }
-
-    AwaStaticClient_DefineResource(awaClient, IPSO_LIGHT_CONTROL_OBJECT, IPSO_LIGHT_CONTROL_CUMULATIVE_ACTIVE_POWER, "CumulativeActivePower", AwaResourceType_Float, 0, 1,
-        AwaResourceOperations_ReadOnly);
-    error = AwaStaticClient_SetResourceOperationHandler(awaClient, IPSO_LIGHT_CONTROL_OBJECT, IPSO_LIGHT_CONTROL_CUMULATIVE_ACTIVE_POWER, lightControlHandler);
-    if (error != AwaError_Success)
+    if (LibObjects_DefineResources(awaClient, &LightControlResourceTable, lightControlHandler) != AwaError_Success)
     {
-        printf("Failed to define CumulativeActivePower resource\n");
         return -1;
     }
-
-    AwaStaticClient_DefineResource(awaClient, IPSO_LIGHT_CONTROL_OBJECT, IPSO_LIGHT_CONTROL_POWER_FACTOR, "PowerFactor", AwaResourceType_Float, 0, 1,
-        AwaResourceOperations_ReadOnly);
-    error = AwaStaticClient_SetResourceOperationHandler(awaClient, IPSO_LIGHT_CONTROL_OBJECT , IPSO_LIGHT_CONTROL_POWER_FACTOR, lightControlHandler);
-    if (error != AwaError_Success)
-    {
-        printf("Failed to define PowerFactor resource\n");
-        return -1;
-    }
-
     return 0;
 }
 
 int LightControl_AddLightControl(AwaStaticClient *awaClient, ObjectInstanceIDType objectInstanceID,
     LightControlCallBack callback, void *callbackContext)
 {
+    IPSOLightControl *lightControls = LibObjects_GetContext(awaClient)->LightControls;
     if ((awaClient == NULL) || (objectInstanceID < 0) || (objectInstanceID >= LIGHT_CONTROLS))
     {
         printf("Invalid arguments passed to %s", __func__);
@@ -321,31 +216,46 @@ int LightControl_AddLightControl(AwaStaticClient *awaClient, ObjectInstanceIDTyp
     AwaStaticClient_CreateResource(awaClient, IPSO_LIGHT_CONTROL_OBJECT, objectInstanceID, IPSO_LIGHT_CONTROL_COLOUR);
     AwaStaticClient_CreateResource(awaClient, IPSO_LIGHT_CONTROL_OBJECT, objectInstanceID, IPSO_LIGHT_CONTROL_ON_TIME);
     lightControls[objectInstanceID].OnOff = false;
-    snprintf(lightControls[objectInstanceID].Colour, sizeof(lightControls[objectInstanceID].Colour), "Red%d", objectInstanceID+1);
+    lightControls[objectInstanceID].Dimmer = 100;
+    LightControl_Account(&lightControls[objectInstanceID]);
+    lightControls[objectInstanceID].Colour.Length = snprintf(lightControls[objectInstanceID].Colour.Value,
+        sizeof(lightControls[objectInstanceID].Colour.Value), "Red%d", objectInstanceID+1);
     lightControls[objectInstanceID].callback = callback;
     lightControls[objectInstanceID].context = callbackContext;
     if (callback != NULL)
     {
         lightControls[objectInstanceID].callback(lightControls[objectInstanceID].context,
             lightControls[objectInstanceID].OnOff, lightControls[objectInstanceID].Dimmer,
-            lightControls[objectInstanceID].Colour);
+            lightControls[objectInstanceID].Colour.Value);
     }
     return 0;
 }
 
 int LightControl_IncrementOnTime(AwaStaticClient *awaClient, ObjectInstanceIDType objectInstanceID, AwaInteger seconds)
 {
+    IPSOLightControl *lightControls;
     if ((awaClient == NULL) || (objectInstanceID < 0) || (objectInstanceID >= LIGHT_CONTROLS))
     {
         printf("Invalid arguments passed to %s", __func__);
         return -1;
     }
 
-    if(lightControls[objectInstanceID].OnOff != true)
+    /* On Time already runs from the time On/Off was written, adding to it would count it twice */
+    lightControls = LibObjects_GetContext(awaClient)->LightControls;
+    return lightControls[objectInstanceID].OnOff ? 0 : -1;
+}
+
+int LightControl_SetRatedPower(AwaStaticClient *awaClient, ObjectInstanceIDType objectInstanceID, AwaFloat ratedPower)
+{
+    IPSOLightControl *lightControls;
+    if ((awaClient == NULL) || (objectInstanceID < 0) || (objectInstanceID >= LIGHT_CONTROLS) || (ratedPower < 0))
     {
+        printf("Invalid arguments passed to %s", __func__);
         return -1;
     }
 
-    lightControls[objectInstanceID].OnTime += seconds;
+    lightControls = LibObjects_GetContext(awaClient)->LightControls;
+    LightControl_Account(&lightControls[objectInstanceID]);
+    lightControls[objectInstanceID].RatedPower = ratedPower;
     return 0;
 }
@@ -38,11 +38,38 @@
 
 #include "lwm2m_core.h"
 
+#define LIGHT_CONTROLS                                   2
+
+/* Read-only Units of all light controls */
+#ifndef LIGHT_CONTROL_UNITS
+#define LIGHT_CONTROL_UNITS                              ""
+#endif
 
 typedef void (*LightControlCallBack)(void *context, bool OnOff, unsigned char Dimmer, const char *Colour);
 int DefineLightControlObject(AwaStaticClient *awaClient);
+
+/*
+ * Creates a light control instance, initially off at full Dimmer (100) so that Cumulative Active Power counts the
+ * rated power until Dimmer is written. Earlier versions started at Dimmer 0, callback sees the new initial value.
+ */
 int LightControl_AddLightControl(AwaStaticClient *awaClient, ObjectInstanceIDType objectInstanceID,
 	LightControlCallBack callback, void *callbackContext);
+
+/*
+ * Deprecated: On Time and Cumulative Active Power are accounted by the library from the times On/Off and Dimmer are
+ * written. Kept for existing callers, this no longer adds to On Time but still returns 0 while the light is on and -1
+ * while it is off or on invalid arguments.
+ */
 int LightControl_IncrementOnTime(AwaStaticClient *awaClient, ObjectInstanceIDType objectInstanceID, AwaInteger seconds);
 
+/**
+ * @brief Sets the active power the light draws at full Dimmer, Cumulative Active Power grows by it scaled by Dimmer
+ *  while the light is on. It is 0 until set, which leaves Cumulative Active Power unchanged.
+ * @param awaClient Reference to AWA client handle
+ * @param objectInstanceID Light control instance
+ * @param ratedPower Power in W
+ * @return 0 on success, -1 on invalid arguments.
+ */
+int LightControl_SetRatedPower(AwaStaticClient *awaClient, ObjectInstanceIDType objectInstanceID, AwaFloat ratedPower);
+
 #endif /* LWM2M_CLIENT_IPSO_LIGHT_CONTROL_H_ */
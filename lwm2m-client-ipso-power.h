@@ -52,12 +52,22 @@
 #define IPSO_POWER_RESET_MIN_AND_MAX_MEASURED_VALUES  5605
 #define IPSO_POWER_APPLICATION_TYPE                   5750
 
+/* Number of Power object instances, instance IDs are 0 .. POWER_SENSORS - 1 */
+#ifndef POWER_SENSORS
+#define POWER_SENSORS                                 1
+#endif
+
+/* Units per AwaFloat unit when stored with IPSO_SENSOR_FIXED_POINT, i.e. milliwatts */
+#ifndef POWER_FIXED_SCALE
+#define POWER_FIXED_SCALE                             1000
+#endif
+
 /***************************************************************************************************
  * Functions
  **************************************************************************************************/
 
 /**
- * @brief Define single IPSO Power object (with ID 3328) and all resources bound to it. It also takes min and max measurable powers as a parameters.
+ * @brief Define IPSO Power object (with ID 3328), all resources bound to it and POWER_SENSORS instances of it. It also takes min and max measurable powers as a parameters.
  *  Range defined in this way is hardware specific and should be choosen from tech specification of used device.
  * @param awaClient Reference to AWA client handle
  * @param minRange Minimal power which can be measured and represented by this object
@@ -75,4 +85,24 @@ AwaError PowerObject_DefineObjectsAndResources(AwaStaticClient *awaClient, AwaFl
  */
 AwaError PowerObject_SetPower(AwaStaticClient *awaClient, AwaFloat power);
 
+/**
+ * @brief Updates current value of power for one object instance. Call to this method updates also Min/Max measured values
+ *  of that instance.
+ * @param awaClient Reference to AWA client handle
+ * @param objectInstanceID ID of the object instance, between 0 and POWER_SENSORS - 1
+ * @param power New value for power resource (Sensor value)
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError PowerObject_SetPowerInstance(AwaStaticClient *awaClient, AwaObjectInstanceID objectInstanceID, AwaFloat power);
+
+/**
+ * @brief Updates current value of power from a block of samples, e.g. one DMA transfer. The last sample becomes the current
+ *  value, Min/Max measured values cover the whole block and each changed resource is notified once.
+ * @param awaClient Reference to AWA client handle
+ * @param samples Power samples in the order they were taken
+ * @param count Number of samples, at least one
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError PowerObject_SetPowerBatch(AwaStaticClient *awaClient, const AwaFloat *samples, size_t count);
+
 #endif /* LWM2M_CLIENT_IPSO_POWER_H_ */
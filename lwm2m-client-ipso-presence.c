@@ -43,36 +43,58 @@
 #include <string.h>
 #include <awa/static.h>
 #include "lwm2m-client-ipso-presence.h"
+#include "lwm2m-client-libobjects-private.h"
 
 /***************************************************************************************************
- * Typedefs
+ * Definitions
  **************************************************************************************************/
 
-typedef struct
-{
-    AwaBoolean State;
-    AwaInteger StateCounter;
-    char SensorType[8];
-    AwaInteger BusyToClearDelay;
-    AwaInteger ClearToBusyDelay;
-} IPSOPresence;
+/* Bits of IPSOPresence.Dirty, indices to PresenceDirtyResources */
+#define PRESENCE_DIRTY_STATE                    (1 << 0)
+#define PRESENCE_DIRTY_COUNTER                  (1 << 1)
 
 /***************************************************************************************************
  * Globals
  **************************************************************************************************/
 
-static IPSOPresence PresenceStorage = {
-  .SensorType = "IR PIR"
+static const AwaResourceID PresenceDirtyResources[] = {
+    IPSO_PRESENCE_DIGITAL_INPUT_STATE,
+    IPSO_PRESENCE_DIGITAL_INPUT_COUNTER,
 };
 
 /***************************************************************************************************
  * Implementation
  **************************************************************************************************/
 
+#if LIBOBJECTS_DEFERRED_NOTIFY || (LIBOBJECTS_RING_SIZE > 0)
+static void PresenceObject_MarkDirty(LibObjectsContext *context, uint8_t dirty)
+{
+    if (dirty != 0)
+    {
+        LIBOBJECTS_SET_BITS(&context->Presence.Dirty, dirty);
+        LIBOBJECTS_SET_BITS(&context->DirtyObjects, LIBOBJECTS_DIRTY_PRESENCE);
+    }
+}
+#endif
+
+/*
+ * Notifies resources changed by an update now, or marks them dirty for LibObjects_Flush.
+ */
+static AwaError PresenceObject_Changed(AwaStaticClient *awaClient, uint8_t dirty)
+{
+#if LIBOBJECTS_DEFERRED_NOTIFY
+    PresenceObject_MarkDirty(LibObjects_GetContext(awaClient), dirty);
+    return AwaError_Success;
+#else
+    return LibObjects_NotifyDirty(awaClient, IPSO_PRESENCE_OBJECT, 0, dirty, PresenceDirtyResources);
+#endif
+}
+
 static AwaResult PresenceObject_Handler(AwaStaticClient *client, AwaOperation operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID,
      AwaResourceID resourceID, AwaResourceInstanceID resourceInstanceID, void **dataPointer, size_t *dataSize, bool *changed)
 {
     AwaResult result = AwaResult_InternalError;
+    IPSOPresence *presence = &LibObjects_GetContext(client)->Presence;
     if ((objectID != IPSO_PRESENCE_OBJECT) || (objectInstanceID != 0))
     {
         printf("Incorrect object data\n");
@@ -82,10 +104,8 @@ static AwaResult PresenceObject_Handler(AwaStaticClient *client, AwaOperation op
     switch (operation)
     {
         case AwaOperation_CreateObjectInstance:
-            result = AwaResult_SuccessDeleted;
-            memset(&PresenceStorage, 0, sizeof(PresenceStorage));
-            strncpy(PresenceStorage.SensorType, "IR PIR", 8);
-            PresenceStorage.SensorType[7] = 0;
+            LibObjectsTimer_Cancel(LibObjects_GetContext(client), &presence->DelayTimer);
+            memset(presence, 0, sizeof(*presence));
             result = AwaResult_SuccessCreated;
             break;
 
@@ -96,8 +116,9 @@ static AwaResult PresenceObject_Handler(AwaStaticClient *client, AwaOperation op
         case AwaOperation_Execute:
             if (resourceID == IPSO_PRESENCE_DIGITAL_INPUT_COUNTER_RESET)
             {
-                PresenceStorage.StateCounter = 0;
-                AwaStaticClient_ResourceChanged(client, IPSO_PRESENCE_OBJECT, objectInstanceID, IPSO_PRESENCE_DIGITAL_INPUT_COUNTER);
+                LibObjectsCounter_Reset(&presence->StateCounts);
+                presence->StateCounter = 0;
+                PresenceObject_Changed(client, PRESENCE_DIRTY_COUNTER);
                 result = AwaResult_Success;
             }
             else
@@ -107,8 +128,21 @@ static AwaResult PresenceObject_Handler(AwaStaticClient *client, AwaOperation op
             }
             break;
 
-        case AwaOperation_DeleteObjectInstance:
         case AwaOperation_Read:
+            if (resourceID == IPSO_PRESENCE_DIGITAL_INPUT_COUNTER)
+            {
+                /* Counts may be added by several threads, the value read is taken from them now */
+                presence->StateCounter = LibObjectsCounter_Read(&presence->StateCounts);
+                *dataPointer = &presence->StateCounter;
+                *dataSize = sizeof(presence->StateCounter);
+                result = AwaResult_SuccessContent;
+                break;
+            }
+            printf("Presence - unknown operation (%d)\n", operation);
+            result = AwaResult_InternalError;
+            break;
+
+        case AwaOperation_DeleteObjectInstance:
         case AwaOperation_Write:
         default:
             printf("Presence - unknown operation (%d)\n", operation);
@@ -120,8 +154,9 @@ static AwaResult PresenceObject_Handler(AwaStaticClient *client, AwaOperation op
 
 AwaError PresenceObject_DefineObjectsAndResources(AwaStaticClient *awaClient, AwaInteger busyToClearDelay, AwaInteger clearToBusyDelay)
 {
-    PresenceStorage.BusyToClearDelay = busyToClearDelay;
-    PresenceStorage.ClearToBusyDelay = clearToBusyDelay;
+    IPSOPresence *presence = &LibObjects_GetContext(awaClient)->Presence;
+    presence->BusyToClearDelay = busyToClearDelay;
+    presence->ClearToBusyDelay = clearToBusyDelay;
     AwaError error;
 
     error = AwaStaticClient_DefineObject(awaClient, IPSO_PRESENCE_OBJECT, "Presence", 0, 1);
@@ -134,8 +169,8 @@ AwaError PresenceObject_DefineObjectsAndResources(AwaStaticClient *awaClient, Aw
 
     error = AwaStaticClient_DefineResource(awaClient, IPSO_PRESENCE_OBJECT, IPSO_PRESENCE_DIGITAL_INPUT_STATE, "Digital Input State",
         AwaResourceType_Boolean, 1, 1, AwaResourceOperations_ReadOnly);
-    AwaStaticClient_SetResourceStorageWithPointer(awaClient, IPSO_PRESENCE_OBJECT, IPSO_PRESENCE_DIGITAL_INPUT_STATE, &PresenceStorage.State,
-        sizeof(PresenceStorage.State), 0);
+    AwaStaticClient_SetResourceStorageWithPointer(awaClient, IPSO_PRESENCE_OBJECT, IPSO_PRESENCE_DIGITAL_INPUT_STATE, &presence->State,
+        sizeof(presence->State), 0);
     if (error != AwaError_Success)
     {
         printf("Failed to define 'Digital Input State' resource\n");
@@ -143,9 +178,8 @@ AwaError PresenceObject_DefineObjectsAndResources(AwaStaticClient *awaClient, Aw
     }
 
     error = AwaStaticClient_DefineResource(awaClient, IPSO_PRESENCE_OBJECT, IPSO_PRESENCE_DIGITAL_INPUT_COUNTER, "Digital Input Counter",
-        AwaResourceType_String, 0, 1, AwaResourceOperations_ReadOnly);
-    AwaStaticClient_SetResourceStorageWithPointer(awaClient, IPSO_PRESENCE_OBJECT, IPSO_PRESENCE_DIGITAL_INPUT_COUNTER, &PresenceStorage.StateCounter,
-        sizeof(PresenceStorage.StateCounter), 0);
+        AwaResourceType_Integer, 0, 1, AwaResourceOperations_ReadOnly);
+    AwaStaticClient_SetResourceOperationHandler(awaClient, IPSO_PRESENCE_OBJECT, IPSO_PRESENCE_DIGITAL_INPUT_COUNTER, PresenceObject_Handler);
     if (error != AwaError_Success)
     {
         printf("Failed to define 'Digital Input Counter' resource\n");
@@ -163,8 +197,8 @@ AwaError PresenceObject_DefineObjectsAndResources(AwaStaticClient *awaClient, Aw
 
     error = AwaStaticClient_DefineResource(awaClient, IPSO_PRESENCE_OBJECT, IPSO_PRESENCE_BUSY_TO_CLEAR_DELAY, "Busy to Clear delay",
         AwaResourceType_Integer, 0, 1, AwaResourceOperations_ReadWrite);
-    AwaStaticClient_SetResourceStorageWithPointer(awaClient, IPSO_PRESENCE_OBJECT, IPSO_PRESENCE_BUSY_TO_CLEAR_DELAY, &PresenceStorage.BusyToClearDelay,
-        sizeof(PresenceStorage.BusyToClearDelay), 0);
+    AwaStaticClient_SetResourceStorageWithPointer(awaClient, IPSO_PRESENCE_OBJECT, IPSO_PRESENCE_BUSY_TO_CLEAR_DELAY, &presence->BusyToClearDelay,
+        sizeof(presence->BusyToClearDelay), 0);
     if (error != AwaError_Success)
     {
         printf("Failed to define 'Busy to Clear delay' resource\n");
@@ -172,9 +206,9 @@ AwaError PresenceObject_DefineObjectsAndResources(AwaStaticClient *awaClient, Aw
     }
 
     error = AwaStaticClient_DefineResource(awaClient, IPSO_PRESENCE_OBJECT, IPSO_PRESENCE_CLEAR_TO_BUSY_DELAY, "Clear to Busy delay",
-        AwaResourceType_Float, 0, 1, AwaResourceOperations_ReadOnly);
-    AwaStaticClient_SetResourceStorageWithPointer(awaClient, IPSO_PRESENCE_OBJECT, IPSO_PRESENCE_CLEAR_TO_BUSY_DELAY, &PresenceStorage.ClearToBusyDelay,
-        sizeof(PresenceStorage.ClearToBusyDelay), 0);
+        AwaResourceType_Integer, 0, 1, AwaResourceOperations_ReadWrite);
+    AwaStaticClient_SetResourceStorageWithPointer(awaClient, IPSO_PRESENCE_OBJECT, IPSO_PRESENCE_CLEAR_TO_BUSY_DELAY, &presence->ClearToBusyDelay,
+        sizeof(presence->ClearToBusyDelay), 0);
     if (error != AwaError_Success)
     {
         printf("Failed to define 'Clear to Busy delay' resource\n");
@@ -198,20 +232,120 @@ AwaError PresenceObject_DefineObjectsAndResources(AwaStaticClient *awaClient, Aw
 }
 
 
+/*
+ * Commits new state, the counter is increased when it differs from the current one. Returns PRESENCE_DIRTY_* bits of
+ * the resources it has changed.
+ */
+static uint8_t PresenceObject_Commit(IPSOPresence *presence, AwaBoolean state)
+{
+    AwaBoolean previous;
+#if LIBOBJECTS_THREAD_SAFE
+    /* Each change is counted once by the thread that made it */
+    previous = __atomic_exchange_n(&presence->State, state, __ATOMIC_RELAXED);
+#else
+    previous = presence->State;
+    presence->State = state;
+#endif
+    if (state != previous) {
+        LibObjectsCounter_Add(&presence->StateCounts, 1);
+        return PRESENCE_DIRTY_STATE | PRESENCE_DIRTY_COUNTER;
+    }
+    return 0;
+}
+
+/*
+ * The input has stayed at the opposite of State for the whole delay.
+ */
+static void PresenceObject_DelayExpired(AwaStaticClient *awaClient, LibObjectsContext *context, LibObjectsTimer *timer)
+{
+    IPSOPresence *presence = LIBOBJECTS_CONTAINER_OF(timer, IPSOPresence, DelayTimer);
+    if (presence->Pending)
+    {
+        presence->Pending = false;
+        PresenceObject_Changed(awaClient, PresenceObject_Commit(presence, !presence->State));
+    }
+}
+
+/*
+ * Applies raw input of the sensor at time now. A change is committed once the input has stayed at the new state for
+ * Clear to Busy delay or Busy to Clear delay ms, input going back in between cancels it. Returns PRESENCE_DIRTY_* bits
+ * of the resources changed right away.
+ */
+static uint8_t PresenceObject_Update(LibObjectsContext *context, IPSOPresence *presence, AwaBoolean state, LibObjectsTime now)
+{
+    AwaInteger delay = state ? presence->ClearToBusyDelay : presence->BusyToClearDelay;
+
+    if (state == presence->State)
+    {
+        if (presence->Pending)
+        {
+            presence->Pending = false;
+            LibObjectsTimer_Cancel(context, &presence->DelayTimer);
+        }
+        return 0;
+    }
+    if (delay <= 0)
+    {
+        if (presence->Pending)
+        {
+            presence->Pending = false;
+            LibObjectsTimer_Cancel(context, &presence->DelayTimer);
+        }
+        return PresenceObject_Commit(presence, state);
+    }
+    if (!presence->Pending)
+    {
+        presence->Pending = true;
+        LibObjectsTimer_Schedule(context, &presence->DelayTimer, now + delay, PresenceObject_DelayExpired);
+    }
+    return 0;
+}
+
 AwaError PresenceObject_SetPresence(AwaStaticClient *awaClient, AwaBoolean state)
 {
     if (awaClient != NULL)
     {
-        AwaError error;
-        if (state != PresenceStorage.State) {
-            PresenceStorage.State = state;
-            error = AwaStaticClient_ResourceChanged(awaClient, IPSO_PRESENCE_OBJECT, 0, IPSO_PRESENCE_DIGITAL_INPUT_STATE);
+        LibObjectsContext *context = LibObjects_GetContext(awaClient);
+        PresenceObject_Changed(awaClient, PresenceObject_Update(context, &context->Presence, state, LibObjects_GetTime()));
+        return AwaError_Success;
+    }
+    else
+    {
+        printf("Invalid arguments passed to %s", __func__);
+        return AwaError_Unspecified;
+    }
+}
 
-            if (error == AwaError_Success) {
-                PresenceStorage.StateCounter ++;
-                error = AwaStaticClient_ResourceChanged(awaClient, IPSO_PRESENCE_OBJECT, 0, IPSO_PRESENCE_DIGITAL_INPUT_COUNTER);
-            }
+AwaError PresenceObject_CommitPresence(AwaStaticClient *awaClient, AwaBoolean state)
+{
+    if (awaClient != NULL)
+    {
+        /* Does not touch the delay timer, so it is safe from any thread */
+        PresenceObject_Changed(awaClient, PresenceObject_Commit(&LibObjects_GetContext(awaClient)->Presence, state));
+        return AwaError_Success;
+    }
+    else
+    {
+        printf("Invalid arguments passed to %s", __func__);
+        return AwaError_Unspecified;
+    }
+}
+
+#if LIBOBJECTS_RING_SIZE > 0
+
+AwaError PresenceObject_PushPresence(AwaStaticClient *awaClient, AwaBoolean state)
+{
+    if (awaClient != NULL)
+    {
+        LibObjectsContext *context = LibObjects_GetContext(awaClient);
+        uint32_t head;
+        if (!LibObjectsRing_Reserve(&context->PresenceRing, &head))
+        {
+            return AwaError_OutOfMemory;
         }
+        context->PresenceSamples[LIBOBJECTS_RING_SLOT(head)].State = state;
+        context->PresenceSamples[LIBOBJECTS_RING_SLOT(head)].Time = LibObjects_GetTime();
+        LibObjectsRing_Commit(&context->PresenceRing, head);
         return AwaError_Success;
     }
     else
@@ -220,3 +354,23 @@ AwaError PresenceObject_SetPresence(AwaStaticClient *awaClient, AwaBoolean state
         return AwaError_Unspecified;
     }
 }
+
+void PresenceObject_Drain(AwaStaticClient *awaClient, LibObjectsContext *context)
+{
+    uint32_t tail;
+    uint32_t head = LibObjectsRing_Peek(&context->PresenceRing, &tail);
+
+    for (; tail != head; tail++)
+    {
+        IPSOPresenceSample *sample = &context->PresenceSamples[LIBOBJECTS_RING_SLOT(tail)];
+        PresenceObject_MarkDirty(context, PresenceObject_Update(context, &context->Presence, sample->State, sample->Time));
+    }
+    LibObjectsRing_Release(&context->PresenceRing, tail);
+}
+
+#endif /* LIBOBJECTS_RING_SIZE > 0 */
+
+void PresenceObject_Flush(AwaStaticClient *awaClient, LibObjectsContext *context)
+{
+    LibObjects_NotifyDirty(awaClient, IPSO_PRESENCE_OBJECT, 0, LIBOBJECTS_TAKE_BITS(&context->Presence.Dirty), PresenceDirtyResources);
+}
@@ -37,6 +37,7 @@
 #define LWM2M_CLIENT_IPSO_PRESENCE_H_
 
 #include "awa/static.h"
+#include "lwm2m-client-libobjects.h"
 
 /***************************************************************************************************
  * Macros
@@ -62,9 +63,33 @@
 AwaError PresenceObject_DefineObjectsAndResources(AwaStaticClient *awaClient, AwaInteger busyToClearDelay, AwaInteger clearToBusyDelay);
 
 /**
- * @brief Sets current state of presence object, and increase Input counter by one.
+ * @brief Feeds raw input of the presence sensor. A change of state is committed, increasing Input counter by one and
+ *  notified once, when the input has stayed at it for Clear to Busy delay (to busy) or Busy to Clear delay (to clear) ms,
+ *  on the LibObjects_Tick reaching the end of the delay. Input going back in between is discarded. With both delays 0,
+ *  changes are committed right away. The delay timer is run by LibObjects_Tick, so this has to be called from the thread
+ *  running AwaStaticClient_Process, other threads use PresenceObject_PushPresence.
  * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
  */
 AwaError PresenceObject_SetPresence(AwaStaticClient *awaClient, AwaBoolean state);
 
+/**
+ * @brief Commits new state of presence object right away, without Busy to Clear and Clear to Busy delays, for inputs
+ *  already debounced by the caller. A change of state increases Input counter by one. With LIBOBJECTS_THREAD_SAFE it may
+ *  be called from any number of threads at once, every change of state being counted exactly once. It must not be mixed
+ *  with PresenceObject_SetPresence or PresenceObject_PushPresence.
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError PresenceObject_CommitPresence(AwaStaticClient *awaClient, AwaBoolean state);
+
+#if LIBOBJECTS_RING_SIZE > 0
+/**
+ * @brief Queues new state of presence object, applied like PresenceObject_SetPresence by the next LibObjects_Drain.
+ *  Delays run from the time the state was queued. Safe to call from one producer thread while the Awa thread is
+ *  processing.
+ * @return AwaError_Success if the state was queued, AwaError_OutOfMemory if the queue is full, to map other values please
+ *  refer to AwaError type.
+ */
+AwaError PresenceObject_PushPresence(AwaStaticClient *awaClient, AwaBoolean state);
+#endif
+
 #endif /* LWM2M_CLIENT_IPSO_PRESENCE_H_ */
@@ -0,0 +1,1770 @@
+/**
+ * @file
+ * LightWeightM2M LWM2M generic IPSO sensor object.
+ *
+ * @author Imagination Technologies
+ *
+ * @copyright Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group
+ * companies and/or licensors.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/***************************************************************************************************
+ * Includes
+ **************************************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#if IPSO_SENSOR_STATISTICS
+#include <math.h>
+#endif
+#include <awa/static.h>
+#if IPSO_SENSOR_FIXED_POINT
+#elif defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+#include "lwm2m-client-ipso-sensor.h"
+#include "lwm2m-client-libobjects-private.h"
+
+/***************************************************************************************************
+ * Definitions
+ **************************************************************************************************/
+
+#if LIBOBJECTS_THREAD_SAFE || IPSO_SENSOR_FIXED_POINT
+/* Resources updated by IPSOSensor_SetValue are read through IPSOSensor_Handler, under the sequence lock */
+#define IPSO_SENSOR_LOCKED_STORAGE(pointer)     NULL
+#else
+#define IPSO_SENSOR_LOCKED_STORAGE(pointer)     (pointer)
+#endif
+
+#if IPSO_SENSOR_FIXED_POINT
+/* Fixed-point resources are converted to AwaFloat by IPSOSensor_Handler */
+#define IPSO_SENSOR_FLOAT_STORAGE(pointer)      NULL
+#define IPSO_SENSOR_FRACTION_BITS               16
+/* Samples converted to fixed-point at once by IPSOSensor_SetValueBatch */
+#define IPSO_SENSOR_CONVERSION_CHUNK            32
+#else
+#define IPSO_SENSOR_FLOAT_STORAGE(pointer)      (pointer)
+#endif
+
+/* Bits of IPSOSensorInstance.Dirty, indices to IPSOSensorDirtyResources */
+#define IPSO_SENSOR_DIRTY_VALUE                 (1 << 0)
+#define IPSO_SENSOR_DIRTY_MIN                   (1 << 1)
+#define IPSO_SENSOR_DIRTY_MAX                   (1 << 2)
+
+/* Entries of IPSOSensorExtremes, one per slot of the period plus the partial slot at its start */
+#define IPSO_SENSOR_RECENT_CAPACITY             (IPSO_SENSOR_RECENT_SLOTS + 1)
+
+/***************************************************************************************************
+ * Globals
+ **************************************************************************************************/
+
+static const AwaResourceID IPSOSensorDirtyResources[] = {
+    IPSO_SENSOR_VALUE,
+    IPSO_SENSOR_MIN_MEASURED_VALUE,
+    IPSO_SENSOR_MAX_MEASURED_VALUE,
+};
+
+#if IPSO_SENSOR_QUANTILES
+/* Quantile estimated by each sketch of IPSOSensorQuantiles, and the resource serving it */
+static const AwaFloat IPSOSensorQuantileValues[IPSO_SENSOR_QUANTILE_COUNT] = { 0.5, 0.95, 0.99 };
+
+static const AwaResourceID IPSOSensorQuantileResources[IPSO_SENSOR_QUANTILE_COUNT] = {
+    IPSO_SENSOR_PERCENTILE_50,
+    IPSO_SENSOR_PERCENTILE_95,
+    IPSO_SENSOR_PERCENTILE_99,
+};
+
+static const char *IPSOSensorQuantileNames[IPSO_SENSOR_QUANTILE_COUNT] = {
+    "50th Percentile",
+    "95th Percentile",
+    "99th Percentile",
+};
+#endif
+
+/***************************************************************************************************
+ * Implementation
+ **************************************************************************************************/
+
+#if LIBOBJECTS_THREAD_SAFE
+
+/*
+ * Writers make the sequence odd while they update Value and Min/Max Measured Value, readers retry until they see
+ * the same even sequence before and after copying a value. Readers never block writers, concurrent writers of the
+ * same instance (sampling thread and the reset execute) spin on each other for the duration of one update.
+ */
+static uint32_t IPSOSensor_BeginWrite(IPSOSensorInstance *instance)
+{
+    uint32_t sequence;
+    do
+    {
+        sequence = __atomic_load_n(&instance->Sequence, __ATOMIC_RELAXED) & ~1u;
+    } while (!__atomic_compare_exchange_n(&instance->Sequence, &sequence, sequence + 1, true, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED));
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    return sequence;
+}
+
+static void IPSOSensor_EndWrite(IPSOSensorInstance *instance, uint32_t sequence)
+{
+    __atomic_store_n(&instance->Sequence, sequence + 2, __ATOMIC_RELEASE);
+}
+
+#else
+
+static uint32_t IPSOSensor_BeginWrite(IPSOSensorInstance *instance)
+{
+    return 0;
+}
+
+static void IPSOSensor_EndWrite(IPSOSensorInstance *instance, uint32_t sequence)
+{
+}
+
+#endif /* LIBOBJECTS_THREAD_SAFE */
+
+/*
+ * Conversions between AwaFloat and the storage of a sensor object, a no-op unless IPSO_SENSOR_FIXED_POINT is set.
+ */
+static inline AwaFloat IPSOSensor_Scale(const IPSOSensor *sensor)
+{
+#if IPSO_SENSOR_FIXED_POINT
+    return ((sensor != NULL) && (sensor->Descriptor->Scale != 0)) ? sensor->Descriptor->Scale : 1;
+#else
+    return 1;
+#endif
+}
+
+static inline IPSOSensorValue IPSOSensor_FromFloat(const IPSOSensor *sensor, AwaFloat value)
+{
+#if IPSO_SENSOR_FIXED_POINT
+    value = value * IPSOSensor_Scale(sensor) + ((value < 0) ? -0.5 : 0.5);
+    return (value <= INT32_MIN) ? INT32_MIN : (value >= INT32_MAX) ? INT32_MAX : (IPSOSensorValue)value;
+#else
+    return value;
+#endif
+}
+
+static inline AwaFloat IPSOSensor_ToFloat(const IPSOSensor *sensor, IPSOSensorValue value)
+{
+#if IPSO_SENSOR_FIXED_POINT
+    return value / IPSOSensor_Scale(sensor);
+#else
+    return value;
+#endif
+}
+
+#if LIBOBJECTS_THREAD_SAFE || IPSO_SENSOR_FIXED_POINT || IPSO_SENSOR_STATISTICS || IPSO_SENSOR_QUANTILES || IPSO_SENSOR_RECENT_EXTREMES
+
+/*
+ * Read section of instance state kept up to date by IPSOSensor_Track: copies taken between IPSOSensor_BeginRead and
+ * IPSOSensor_EndRead are consistent with each other if IPSOSensor_EndRead returns true, otherwise they are taken again.
+ */
+static inline uint32_t IPSOSensor_BeginRead(IPSOSensorInstance *instance)
+{
+#if LIBOBJECTS_THREAD_SAFE
+    return __atomic_load_n(&instance->Sequence, __ATOMIC_ACQUIRE);
+#else
+    return 0;
+#endif
+}
+
+static inline bool IPSOSensor_EndRead(IPSOSensorInstance *instance, uint32_t begin)
+{
+#if LIBOBJECTS_THREAD_SAFE
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    return !(begin & 1) && (begin == __atomic_load_n(&instance->Sequence, __ATOMIC_RELAXED));
+#else
+    return true;
+#endif
+}
+
+#endif
+
+#if LIBOBJECTS_THREAD_SAFE || IPSO_SENSOR_FIXED_POINT || IPSO_SENSOR_STATISTICS || IPSO_SENSOR_QUANTILES
+
+/*
+ * Copies size bytes of instance state kept up to date by IPSOSensor_Track, consistent with concurrent updates.
+ */
+static void IPSOSensor_ReadCopy(IPSOSensorInstance *instance, void *copy, const void *source, size_t size)
+{
+    uint32_t begin;
+    do
+    {
+        begin = IPSOSensor_BeginRead(instance);
+        memcpy(copy, source, size);
+    } while (!IPSOSensor_EndRead(instance, begin));
+}
+
+#endif
+
+#if LIBOBJECTS_THREAD_SAFE || IPSO_SENSOR_FIXED_POINT
+
+/*
+ * Consistent copy of a value updated by IPSOSensor_SetValue, as AwaFloat.
+ */
+static AwaFloat *IPSOSensor_ReadValue(const IPSOSensor *sensor, IPSOSensorInstance *instance, const IPSOSensorValue *value)
+{
+    IPSOSensorValue copy;
+    IPSOSensor_ReadCopy(instance, &copy, value, sizeof(copy));
+    instance->Snapshot = IPSOSensor_ToFloat(sensor, copy);
+    return &instance->Snapshot;
+}
+
+#endif
+
+#if IPSO_SENSOR_STATISTICS
+
+static void IPSOSensor_Accumulate(IPSOSensorStatistics *statistics, AwaFloat value)
+{
+    AwaFloat delta = value - statistics->Mean;
+    statistics->Count++;
+    statistics->Mean += delta / statistics->Count;
+    statistics->SquaredDeviations += delta * (value - statistics->Mean);
+}
+
+/*
+ * Derives the requested statistic from the accumulator, standard deviation is the sample one (n - 1).
+ */
+static void *IPSOSensor_ReadStatistic(const IPSOSensor *sensor, IPSOSensorInstance *instance, AwaResourceID resourceID)
+{
+    IPSOSensorStatistics statistics;
+    IPSOSensor_ReadCopy(instance, &statistics, &instance->Statistics, sizeof(statistics));
+    switch (resourceID)
+    {
+        case IPSO_SENSOR_MEAN_VALUE:
+            instance->Statistic.Float = statistics.Mean / IPSOSensor_Scale(sensor);
+            break;
+
+        case IPSO_SENSOR_STANDARD_DEVIATION:
+            instance->Statistic.Float = (statistics.Count > 1) ?
+                sqrt(statistics.SquaredDeviations / (statistics.Count - 1)) / IPSOSensor_Scale(sensor) : 0;
+            break;
+
+        default:
+            instance->Statistic.Integer = statistics.Count;
+            break;
+    }
+    return &instance->Statistic;
+}
+
+#endif /* IPSO_SENSOR_STATISTICS */
+
+#if IPSO_SENSOR_QUANTILES
+
+/*
+ * P² height adjustment of marker i by step (+1 or -1), falls back to linear interpolation when the parabola would
+ * leave the neighbouring heights.
+ */
+static AwaFloat IPSOSensor_AdjustMarker(const IPSOSensorQuantileSketch *sketch, int i, int step)
+{
+    const AwaFloat *q = sketch->Heights;
+    const int64_t *n = sketch->Positions;
+    AwaFloat height = q[i] + (AwaFloat)step / (n[i + 1] - n[i - 1]) *
+        ((n[i] - n[i - 1] + step) * (q[i + 1] - q[i]) / (n[i + 1] - n[i]) +
+         (n[i + 1] - n[i] - step) * (q[i] - q[i - 1]) / (n[i] - n[i - 1]));
+
+    if ((height <= q[i - 1]) || (height >= q[i + 1]))
+    {
+        height = q[i] + step * (q[i + step] - q[i]) / (n[i + step] - n[i]);
+    }
+    return height;
+}
+
+static void IPSOSensor_UpdateSketch(IPSOSensorQuantileSketch *sketch, AwaFloat quantile, AwaFloat value)
+{
+    const AwaFloat increments[IPSO_SENSOR_QUANTILE_MARKERS] = { 0, quantile / 2, quantile, (1 + quantile) / 2, 1 };
+    int last = IPSO_SENSOR_QUANTILE_MARKERS - 1;
+    int cell;
+    int i;
+
+    if (value < sketch->Heights[0])
+    {
+        sketch->Heights[0] = value;
+        cell = 0;
+    }
+    else if (value >= sketch->Heights[last])
+    {
+        sketch->Heights[last] = value;
+        cell = last - 1;
+    }
+    else
+    {
+        for (cell = 0; value >= sketch->Heights[cell + 1]; cell++)
+        {
+        }
+    }
+
+    for (i = cell + 1; i <= last; i++)
+    {
+        sketch->Positions[i]++;
+    }
+    for (i = 0; i <= last; i++)
+    {
+        sketch->Desired[i] += increments[i];
+    }
+    for (i = 1; i < last; i++)
+    {
+        AwaFloat offset = sketch->Desired[i] - sketch->Positions[i];
+        if (((offset >= 1) && (sketch->Positions[i + 1] - sketch->Positions[i] > 1)) ||
+            ((offset <= -1) && (sketch->Positions[i - 1] - sketch->Positions[i] < -1)))
+        {
+            int step = (offset > 0) ? 1 : -1;
+            sketch->Heights[i] = IPSOSensor_AdjustMarker(sketch, i, step);
+            sketch->Positions[i] += step;
+        }
+    }
+}
+
+static void IPSOSensor_AddQuantileSample(IPSOSensorQuantiles *quantiles, AwaFloat value)
+{
+    int i;
+    for (i = 0; i < IPSO_SENSOR_QUANTILE_COUNT; i++)
+    {
+        IPSOSensorQuantileSketch *sketch = &quantiles->Sketches[i];
+        if (quantiles->Count < IPSO_SENSOR_QUANTILE_MARKERS)
+        {
+            // Still collecting the initial marker heights, keep them sorted
+            uint32_t j;
+            for (j = quantiles->Count; (j > 0) && (sketch->Heights[j - 1] > value); j--)
+            {
+                sketch->Heights[j] = sketch->Heights[j - 1];
+            }
+            sketch->Heights[j] = value;
+        }
+        else
+        {
+            IPSOSensor_UpdateSketch(sketch, IPSOSensorQuantileValues[i], value);
+        }
+    }
+
+    if (++quantiles->Count == IPSO_SENSOR_QUANTILE_MARKERS)
+    {
+        for (i = 0; i < IPSO_SENSOR_QUANTILE_COUNT; i++)
+        {
+            IPSOSensorQuantileSketch *sketch = &quantiles->Sketches[i];
+            AwaFloat quantile = IPSOSensorQuantileValues[i];
+            int marker;
+            for (marker = 0; marker < IPSO_SENSOR_QUANTILE_MARKERS; marker++)
+            {
+                sketch->Positions[marker] = marker;
+            }
+            sketch->Desired[0] = 0;
+            sketch->Desired[1] = 2 * quantile;
+            sketch->Desired[2] = 4 * quantile;
+            sketch->Desired[3] = 2 + 2 * quantile;
+            sketch->Desired[4] = 4;
+        }
+    }
+}
+
+/*
+ * Estimate of the quantile served by resourceID, taken from the sorted samples while there are too few for P².
+ */
+static void *IPSOSensor_ReadQuantile(const IPSOSensor *sensor, IPSOSensorInstance *instance, AwaResourceID resourceID)
+{
+    IPSOSensorQuantiles quantiles;
+    int i;
+
+    for (i = 0; IPSOSensorQuantileResources[i] != resourceID; i++)
+    {
+    }
+    IPSOSensor_ReadCopy(instance, &quantiles, &instance->Quantiles, sizeof(quantiles));
+    if (quantiles.Count == 0)
+    {
+        instance->Statistic.Float = 0;
+    }
+    else if (quantiles.Count < IPSO_SENSOR_QUANTILE_MARKERS)
+    {
+        instance->Statistic.Float = quantiles.Sketches[i].Heights[(uint32_t)(IPSOSensorQuantileValues[i] * (quantiles.Count - 1) + 0.5)];
+    }
+    else
+    {
+        instance->Statistic.Float = quantiles.Sketches[i].Heights[IPSO_SENSOR_QUANTILE_MARKERS / 2];
+    }
+    instance->Statistic.Float /= IPSOSensor_Scale(sensor);
+    return &instance->Statistic;
+}
+
+#endif /* IPSO_SENSOR_QUANTILES */
+
+#if IPSO_SENSOR_RECENT_EXTREMES
+
+static IPSOSensorExtreme *IPSOSensor_BackExtreme(IPSOSensorExtremes *extremes)
+{
+    return &extremes->Entries[(extremes->Front + extremes->Count - 1) % IPSO_SENSOR_RECENT_CAPACITY];
+}
+
+/*
+ * Adds value seen at now to the deque of minima or maxima, O(1) amortized.
+ */
+static void IPSOSensor_PushExtreme(IPSOSensorExtremes *extremes, bool minimum, IPSOSensorValue value, LibObjectsTime now,
+    LibObjectsTime period)
+{
+    LibObjectsTime slot = period / IPSO_SENSOR_RECENT_SLOTS;
+    IPSOSensorExtreme *back;
+
+    while ((extremes->Count > 0) && (extremes->Entries[extremes->Front].Time + period <= now))
+    {
+        extremes->Front = (extremes->Front + 1) % IPSO_SENSOR_RECENT_CAPACITY;
+        extremes->Count--;
+    }
+    // Entries not beyond the new value can never be the extreme again
+    while ((extremes->Count > 0) && (minimum ? (IPSOSensor_BackExtreme(extremes)->Value >= value) :
+        (IPSOSensor_BackExtreme(extremes)->Value <= value)))
+    {
+        extremes->Count--;
+    }
+    if (extremes->Count > 0)
+    {
+        back = IPSOSensor_BackExtreme(extremes);
+        if (back->Time / slot == now / slot)
+        {
+            // More extreme value of the same slot, it stays the extreme as long as the new value would
+            back->Time = now;
+            return;
+        }
+    }
+    if (extremes->Count == IPSO_SENSOR_RECENT_CAPACITY)
+    {
+        // Only reachable if the clock went backwards
+        extremes->Front = (extremes->Front + 1) % IPSO_SENSOR_RECENT_CAPACITY;
+        extremes->Count--;
+    }
+    extremes->Count++;
+    back = IPSOSensor_BackExtreme(extremes);
+    back->Time = now;
+    back->Value = value;
+}
+
+/*
+ * Oldest extreme still within the period, the current value if there was no sample within it.
+ */
+static void *IPSOSensor_ReadRecent(const IPSOSensor *sensor, IPSOSensorInstance *instance, AwaResourceID resourceID)
+{
+    bool minimum = (resourceID == IPSO_SENSOR_RECENT_MIN_VALUE);
+    LibObjectsTime now = LibObjects_GetTime();
+    IPSOSensorExtremes extremes;
+    IPSOSensorValue value;
+    AwaInteger period;
+    uint32_t begin;
+    uint32_t i;
+
+    // Period, deque and value from the same update
+    do
+    {
+        begin = IPSOSensor_BeginRead(instance);
+        memcpy(&extremes, minimum ? &instance->RecentMin : &instance->RecentMax, sizeof(extremes));
+        memcpy(&value, &instance->Value, sizeof(value));
+        memcpy(&period, &instance->RecentPeriod, sizeof(period));
+    } while (!IPSOSensor_EndRead(instance, begin));
+
+    for (i = 0; i < extremes.Count; i++)
+    {
+        const IPSOSensorExtreme *extreme = &extremes.Entries[(extremes.Front + i) % IPSO_SENSOR_RECENT_CAPACITY];
+        if (extreme->Time + period > now)
+        {
+            value = extreme->Value;
+            break;
+        }
+    }
+    instance->Statistic.Float = IPSOSensor_ToFloat(sensor, value);
+    return &instance->Statistic;
+}
+
+static bool IPSOSensor_ConfigureRecent(IPSOSensorInstance *instance, AwaInteger period)
+{
+    uint32_t sequence;
+
+    if ((period < 0) || ((period != 0) && (period < IPSO_SENSOR_RECENT_SLOTS)))
+    {
+        return false;
+    }
+    sequence = IPSOSensor_BeginWrite(instance);
+    instance->RecentPeriod = period;
+    memset(&instance->RecentMin, 0, sizeof(instance->RecentMin));
+    memset(&instance->RecentMax, 0, sizeof(instance->RecentMax));
+    IPSOSensor_EndWrite(instance, sequence);
+    return true;
+}
+
+#endif /* IPSO_SENSOR_RECENT_EXTREMES */
+
+/*
+ * Feeds extremes of new samples taken at the same time to the recent extremes, called inside the write section.
+ */
+static void IPSOSensor_TrackExtremes(IPSOSensorInstance *instance, IPSOSensorValue min, IPSOSensorValue max)
+{
+#if IPSO_SENSOR_RECENT_EXTREMES
+    if (instance->RecentPeriod != 0)
+    {
+        LibObjectsTime now = LibObjects_GetTime();
+        IPSOSensor_PushExtreme(&instance->RecentMin, true, min, now, instance->RecentPeriod);
+        IPSOSensor_PushExtreme(&instance->RecentMax, false, max, now, instance->RecentPeriod);
+    }
+#endif
+}
+
+/*
+ * Feeds a new sample to the optional statistics, called inside the write section of the instance.
+ */
+static void IPSOSensor_Track(IPSOSensorInstance *instance, IPSOSensorValue value)
+{
+#if IPSO_SENSOR_STATISTICS
+    IPSOSensor_Accumulate(&instance->Statistics, value);
+#endif
+#if IPSO_SENSOR_QUANTILES
+    IPSOSensor_AddQuantileSample(&instance->Quantiles, value);
+#endif
+}
+
+/*
+ * Restarts the optional statistics together with Min/Max Measured Values.
+ */
+static void IPSOSensor_ResetTracking(IPSOSensorInstance *instance)
+{
+#if IPSO_SENSOR_STATISTICS
+    memset(&instance->Statistics, 0, sizeof(instance->Statistics));
+#endif
+#if IPSO_SENSOR_QUANTILES
+    memset(&instance->Quantiles, 0, sizeof(instance->Quantiles));
+#endif
+}
+
+static IPSOSensor *IPSOSensor_Find(LibObjectsContext *context, AwaObjectID objectID)
+{
+    int i;
+    for (i = 0; i < IPSO_SENSOR_OBJECTS; i++)
+    {
+        if ((context->Sensors[i].Descriptor != NULL) && (context->Sensors[i].Descriptor->ObjectID == objectID))
+        {
+            return &context->Sensors[i];
+        }
+    }
+    return NULL;
+}
+
+static IPSOSensorInstance *IPSOSensor_GetInstance(IPSOSensor *sensor, AwaObjectInstanceID objectInstanceID)
+{
+    if ((sensor == NULL) || (objectInstanceID < 0) || (objectInstanceID >= sensor->Descriptor->Instances))
+    {
+        return NULL;
+    }
+    return &sensor->Instances[objectInstanceID];
+}
+
+static IPSOSensorInstance *IPSOSensor_FindInstance(LibObjectsContext *context, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID)
+{
+    return IPSOSensor_GetInstance(IPSOSensor_Find(context, objectID), objectInstanceID);
+}
+
+static IPSOSensor *IPSOSensor_Allocate(LibObjectsContext *context, const IPSOSensorDescriptor *descriptor)
+{
+    IPSOSensor *sensor = IPSOSensor_Find(context, descriptor->ObjectID);
+    int i;
+
+    if (sensor != NULL)
+    {
+        // Object defined again, reuse its instances
+        memset(sensor->Instances, 0, descriptor->Instances * sizeof(IPSOSensorInstance));
+        return sensor;
+    }
+
+    if (descriptor->Instances > IPSO_SENSOR_INSTANCES - context->SensorInstancesUsed)
+    {
+        return NULL;
+    }
+
+    for (i = 0; i < IPSO_SENSOR_OBJECTS; i++)
+    {
+        if (context->Sensors[i].Descriptor == NULL)
+        {
+            sensor = &context->Sensors[i];
+            sensor->Descriptor = descriptor;
+            sensor->Instances = &context->SensorInstances[context->SensorInstancesUsed];
+            context->SensorInstancesUsed += descriptor->Instances;
+            break;
+        }
+    }
+    return sensor;
+}
+
+/*
+ * Value has to be notified once it moves out of the deadband around the last notified value. With both deadbands
+ * at 0 every update is notified.
+ */
+static bool IPSOSensor_CrossesDeadband(IPSOSensorInstance *instance, IPSOSensorValue value)
+{
+    IPSOSensorSum delta = (IPSOSensorSum)value - instance->NotifiedValue;
+    IPSOSensorSum magnitude = (instance->NotifiedValue < 0) ? -(IPSOSensorSum)instance->NotifiedValue : instance->NotifiedValue;
+#if IPSO_SENSOR_FIXED_POINT
+    IPSOSensorSum deadband = (instance->RelativeDeadband * magnitude) >> IPSO_SENSOR_FRACTION_BITS;
+#else
+    IPSOSensorSum deadband = instance->RelativeDeadband * magnitude;
+#endif
+
+    if (instance->AbsoluteDeadband > deadband)
+    {
+        deadband = instance->AbsoluteDeadband;
+    }
+    if (((delta < 0) ? -delta : delta) >= deadband)
+    {
+        instance->NotifiedValue = value;
+        return true;
+    }
+    return false;
+}
+
+/*
+ * Stores new value of an instance inside its write section, returns IPSO_SENSOR_DIRTY_* bits of the resources to be
+ * notified.
+ */
+static uint8_t IPSOSensor_Store(IPSOSensorInstance *instance, IPSOSensorValue value)
+{
+    uint8_t changed = 0;
+
+    instance->Value = value;
+    IPSOSensor_Track(instance, value);
+    IPSOSensor_TrackExtremes(instance, value, value);
+    if (IPSOSensor_CrossesDeadband(instance, value)) {
+      changed |= IPSO_SENSOR_DIRTY_VALUE;
+    }
+    if (value < instance->MinMeasuredValue) {
+      instance->MinMeasuredValue = value;
+      changed |= IPSO_SENSOR_DIRTY_MIN;
+    }
+    if (value > instance->MaxMeasuredValue) {
+      instance->MaxMeasuredValue = value;
+      changed |= IPSO_SENSOR_DIRTY_MAX;
+    }
+    return changed;
+}
+
+#if IPSO_SENSOR_WINDOWS
+
+static uint32_t IPSOSensor_WindowSlices(const IPSOSensorWindow *window)
+{
+    return (window->Mode == IPSO_SENSOR_WINDOW_SLIDING) ? IPSO_SENSOR_WINDOW_SLICES : 1;
+}
+
+static void IPSOSensor_AddToWindow(IPSOSensorWindow *window, AwaInteger count, IPSOSensorSum sum, IPSOSensorValue min, IPSOSensorValue max,
+    IPSOSensorValue last)
+{
+    IPSOSensorWindowSlice *slice = &window->Slices[window->Current];
+    if ((slice->Count == 0) || (min < slice->Min))
+    {
+        slice->Min = min;
+    }
+    if ((slice->Count == 0) || (max > slice->Max))
+    {
+        slice->Max = max;
+    }
+    slice->Count += count;
+    slice->Sum += sum;
+    slice->Last = last;
+}
+
+/*
+ * Stores the aggregate of all slices of the window, an empty window publishes nothing.
+ */
+static uint8_t IPSOSensor_PublishWindow(IPSOSensorInstance *instance)
+{
+    IPSOSensorWindow *window = &instance->Window;
+    uint32_t slices = IPSOSensor_WindowSlices(window);
+    IPSOSensorWindowSlice total = { 0 };
+    IPSOSensorValue value;
+    uint32_t i;
+
+    // Newest slice first, so Last comes from the most recent sample
+    for (i = 0; i < slices; i++)
+    {
+        const IPSOSensorWindowSlice *slice = &window->Slices[(window->Current + slices - i) % slices];
+        if (slice->Count == 0)
+        {
+            continue;
+        }
+        if (total.Count == 0)
+        {
+            total = *slice;
+            continue;
+        }
+        total.Count += slice->Count;
+        total.Sum += slice->Sum;
+        total.Min = (slice->Min < total.Min) ? slice->Min : total.Min;
+        total.Max = (slice->Max > total.Max) ? slice->Max : total.Max;
+    }
+    if (total.Count == 0)
+    {
+        return 0;
+    }
+
+    switch (window->Function)
+    {
+        case IPSO_SENSOR_WINDOW_MEAN:
+            value = total.Sum / total.Count;
+            break;
+
+        case IPSO_SENSOR_WINDOW_MIN:
+            value = total.Min;
+            break;
+
+        case IPSO_SENSOR_WINDOW_MAX:
+            value = total.Max;
+            break;
+
+        default:
+            value = total.Last;
+            break;
+    }
+    return IPSOSensor_Store(instance, value);
+}
+
+/*
+ * Closes the slices which ended before now. Only the window ending with the first of them is published, the later
+ * ones hold no newer samples. Returns IPSO_SENSOR_DIRTY_* bits of the resources to be notified.
+ */
+static uint8_t IPSOSensor_AdvanceWindow(IPSOSensorInstance *instance, LibObjectsTime now)
+{
+    IPSOSensorWindow *window = &instance->Window;
+    uint32_t slices = IPSOSensor_WindowSlices(window);
+    LibObjectsTime length = window->Period / slices;
+    LibObjectsTime closed;
+    uint8_t changed;
+    uint32_t i;
+
+    if (window->End == 0)
+    {
+        window->End = now + length;
+        return 0;
+    }
+    if (now < window->End)
+    {
+        return 0;
+    }
+
+    changed = IPSOSensor_PublishWindow(instance);
+    closed = (now - window->End) / length + 1;
+    for (i = 0; (i < closed) && (i < slices); i++)
+    {
+        window->Current = (window->Current + 1) % slices;
+        memset(&window->Slices[window->Current], 0, sizeof(IPSOSensorWindowSlice));
+    }
+    window->End += closed * length;
+    return changed;
+}
+
+#endif /* IPSO_SENSOR_WINDOWS */
+
+/*
+ * Passes new value of an instance through its window to the storage, returns IPSO_SENSOR_DIRTY_* bits of the
+ * resources to be notified.
+ */
+static uint8_t IPSOSensor_Update(IPSOSensorInstance *instance, IPSOSensorValue value)
+{
+    uint8_t changed;
+    uint32_t sequence = IPSOSensor_BeginWrite(instance);
+
+#if IPSO_SENSOR_WINDOWS
+    if (instance->Window.Period != 0)
+    {
+        changed = IPSOSensor_AdvanceWindow(instance, LibObjects_GetTime());
+        IPSOSensor_AddToWindow(&instance->Window, 1, value, value, value, value);
+        IPSOSensor_EndWrite(instance, sequence);
+        return changed;
+    }
+#endif
+    changed = IPSOSensor_Store(instance, value);
+    IPSOSensor_EndWrite(instance, sequence);
+    return changed;
+}
+
+/*
+ * Finds min and max of count (> 0) samples, several lanes at a time where the target has vector instructions.
+ */
+static void IPSOSensor_Reduce(const IPSOSensorValue *samples, size_t count, IPSOSensorValue *min, IPSOSensorValue *max)
+{
+    IPSOSensorValue minimum = samples[0];
+    IPSOSensorValue maximum = samples[0];
+    size_t i = 0;
+
+#if IPSO_SENSOR_FIXED_POINT
+    // Integer loop below, FPU-less targets have no vector unit either
+#elif defined(__AVX__)
+    if (count >= 4)
+    {
+        __m256d vectorMin = _mm256_loadu_pd(samples);
+        __m256d vectorMax = vectorMin;
+        AwaFloat lanes[4];
+        int lane;
+        for (i = 4; i + 4 <= count; i += 4)
+        {
+            __m256d vector = _mm256_loadu_pd(&samples[i]);
+            vectorMin = _mm256_min_pd(vectorMin, vector);
+            vectorMax = _mm256_max_pd(vectorMax, vector);
+        }
+        _mm256_storeu_pd(lanes, vectorMin);
+        for (lane = 0; lane < 4; lane++)
+        {
+            minimum = (lanes[lane] < minimum) ? lanes[lane] : minimum;
+        }
+        _mm256_storeu_pd(lanes, vectorMax);
+        for (lane = 0; lane < 4; lane++)
+        {
+            maximum = (lanes[lane] > maximum) ? lanes[lane] : maximum;
+        }
+    }
+#elif defined(__SSE2__)
+    if (count >= 2)
+    {
+        __m128d vectorMin = _mm_loadu_pd(samples);
+        __m128d vectorMax = vectorMin;
+        AwaFloat lanes[2];
+        for (i = 2; i + 2 <= count; i += 2)
+        {
+            __m128d vector = _mm_loadu_pd(&samples[i]);
+            vectorMin = _mm_min_pd(vectorMin, vector);
+            vectorMax = _mm_max_pd(vectorMax, vector);
+        }
+        _mm_storeu_pd(lanes, vectorMin);
+        minimum = (lanes[0] < lanes[1]) ? lanes[0] : lanes[1];
+        _mm_storeu_pd(lanes, vectorMax);
+        maximum = (lanes[0] > lanes[1]) ? lanes[0] : lanes[1];
+    }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    if (count >= 2)
+    {
+        float64x2_t vectorMin = vld1q_f64(samples);
+        float64x2_t vectorMax = vectorMin;
+        for (i = 2; i + 2 <= count; i += 2)
+        {
+            float64x2_t vector = vld1q_f64(&samples[i]);
+            vectorMin = vminq_f64(vectorMin, vector);
+            vectorMax = vmaxq_f64(vectorMax, vector);
+        }
+        minimum = vminvq_f64(vectorMin);
+        maximum = vmaxvq_f64(vectorMax);
+    }
+#endif
+
+    for (; i < count; i++)
+    {
+        minimum = (samples[i] < minimum) ? samples[i] : minimum;
+        maximum = (samples[i] > maximum) ? samples[i] : maximum;
+    }
+    *min = minimum;
+    *max = maximum;
+}
+
+/*
+ * Stores the last of count samples as the new value, Min/Max Measured Value take the whole batch into account.
+ */
+static uint8_t IPSOSensor_UpdateBatch(IPSOSensorInstance *instance, const IPSOSensorValue *samples, size_t count)
+{
+    uint8_t changed = 0;
+    IPSOSensorValue min;
+    IPSOSensorValue max;
+    uint32_t sequence;
+    size_t i;
+
+    IPSOSensor_Reduce(samples, count, &min, &max);
+    sequence = IPSOSensor_BeginWrite(instance);
+#if IPSO_SENSOR_WINDOWS
+    if (instance->Window.Period != 0)
+    {
+        IPSOSensorSum sum = 0;
+        for (i = 0; i < count; i++)
+        {
+            sum += samples[i];
+        }
+        changed = IPSOSensor_AdvanceWindow(instance, LibObjects_GetTime());
+        IPSOSensor_AddToWindow(&instance->Window, count, sum, min, max, samples[count - 1]);
+        IPSOSensor_EndWrite(instance, sequence);
+        return changed;
+    }
+#endif
+    instance->Value = samples[count - 1];
+    for (i = 0; i < count; i++)
+    {
+        IPSOSensor_Track(instance, samples[i]);
+    }
+    IPSOSensor_TrackExtremes(instance, min, max);
+    if (IPSOSensor_CrossesDeadband(instance, instance->Value)) {
+      changed |= IPSO_SENSOR_DIRTY_VALUE;
+    }
+    if (min < instance->MinMeasuredValue) {
+      instance->MinMeasuredValue = min;
+      changed |= IPSO_SENSOR_DIRTY_MIN;
+    }
+    if (max > instance->MaxMeasuredValue) {
+      instance->MaxMeasuredValue = max;
+      changed |= IPSO_SENSOR_DIRTY_MAX;
+    }
+    IPSOSensor_EndWrite(instance, sequence);
+    return changed;
+}
+
+static void IPSOSensor_MarkDirty(LibObjectsContext *context, IPSOSensorInstance *instance, uint8_t dirty)
+{
+    size_t slot = instance - context->SensorInstances;
+    if (dirty != 0)
+    {
+        LIBOBJECTS_SET_BITS(&instance->Dirty, dirty);
+        LIBOBJECTS_SET_BITS(&context->SensorInstancesDirty[slot / 32], 1u << (slot % 32));
+        LIBOBJECTS_SET_BITS(&context->DirtyObjects, LIBOBJECTS_DIRTY_SENSORS);
+    }
+}
+
+/*
+ * Adds instance to the ones visited by every LibObjects_Flush while it has a maximal period or a window.
+ */
+static void IPSOSensor_Schedule(LibObjectsContext *context, IPSOSensorInstance *instance)
+{
+    size_t slot = instance - context->SensorInstances;
+    bool scheduled = (instance->MaxPeriod != 0);
+
+#if IPSO_SENSOR_WINDOWS
+    scheduled = scheduled || (instance->Window.Period != 0);
+#endif
+    if (scheduled)
+    {
+        context->SensorInstancesScheduled[slot / 32] |= 1u << (slot % 32);
+        context->ScheduledObjects |= LIBOBJECTS_DIRTY_SENSORS;
+    }
+    else
+    {
+        context->SensorInstancesScheduled[slot / 32] &= ~(1u << (slot % 32));
+    }
+}
+
+#if IPSO_SENSOR_WINDOWS
+
+static bool IPSOSensor_ConfigureWindow(LibObjectsContext *context, IPSOSensorInstance *instance, AwaInteger period, AwaInteger mode,
+    AwaInteger function)
+{
+    uint32_t sequence;
+
+    if ((period < 0) || ((mode != IPSO_SENSOR_WINDOW_TUMBLING) && (mode != IPSO_SENSOR_WINDOW_SLIDING)) ||
+        (function < IPSO_SENSOR_WINDOW_LAST) || (function > IPSO_SENSOR_WINDOW_MAX) ||
+        ((mode == IPSO_SENSOR_WINDOW_SLIDING) && (period != 0) && (period < IPSO_SENSOR_WINDOW_SLICES)))
+    {
+        return false;
+    }
+
+    sequence = IPSOSensor_BeginWrite(instance);
+    memset(&instance->Window, 0, sizeof(instance->Window));
+    instance->Window.Period = period;
+    instance->Window.Mode = mode;
+    instance->Window.Function = function;
+    IPSOSensor_EndWrite(instance, sequence);
+    IPSOSensor_Schedule(context, instance);
+    return true;
+}
+
+static AwaResult IPSOSensor_WriteWindow(LibObjectsContext *context, IPSOSensorInstance *instance, AwaResourceID resourceID, AwaInteger value)
+{
+    AwaInteger period = instance->Window.Period;
+    AwaInteger mode = instance->Window.Mode;
+    AwaInteger function = instance->Window.Function;
+
+    switch (resourceID)
+    {
+        case IPSO_SENSOR_WINDOW_PERIOD:
+            period = value;
+            break;
+
+        case IPSO_SENSOR_WINDOW_MODE:
+            mode = value;
+            break;
+
+        case IPSO_SENSOR_WINDOW_FUNCTION:
+            function = value;
+            break;
+
+        default:
+            return AwaResult_InternalError;
+    }
+    return IPSOSensor_ConfigureWindow(context, instance, period, mode, function) ? AwaResult_SuccessChanged : AwaResult_BadRequest;
+}
+
+#endif /* IPSO_SENSOR_WINDOWS */
+
+#if IPSO_SENSOR_WINDOWS || IPSO_SENSOR_RECENT_EXTREMES
+
+static AwaResult IPSOSensor_Write(LibObjectsContext *context, IPSOSensorInstance *instance, AwaResourceID resourceID, AwaInteger value)
+{
+#if IPSO_SENSOR_RECENT_EXTREMES
+    if (resourceID == IPSO_SENSOR_RECENT_PERIOD)
+    {
+        return IPSOSensor_ConfigureRecent(instance, value) ? AwaResult_SuccessChanged : AwaResult_BadRequest;
+    }
+#endif
+#if IPSO_SENSOR_WINDOWS
+    return IPSOSensor_WriteWindow(context, instance, resourceID, value);
+#else
+    return AwaResult_InternalError;
+#endif
+}
+
+#endif
+
+#if IPSO_SENSOR_WINDOWS
+
+/*
+ * Publishes windows which ended without a later update.
+ */
+static void IPSOSensor_CloseWindow(LibObjectsContext *context, IPSOSensorInstance *instance, LibObjectsTime now)
+{
+    uint8_t changed = 0;
+    uint32_t sequence = IPSOSensor_BeginWrite(instance);
+    if (instance->Window.Period != 0)
+    {
+        changed = IPSOSensor_AdvanceWindow(instance, now);
+    }
+    IPSOSensor_EndWrite(instance, sequence);
+    IPSOSensor_MarkDirty(context, instance, changed);
+}
+
+#endif /* IPSO_SENSOR_WINDOWS */
+
+/*
+ * Notifies dirty resources whose minimal period has passed and clean ones whose maximal period has passed, the
+ * remaining dirty resources are left for a later flush.
+ */
+static AwaError IPSOSensor_FlushInstance(AwaStaticClient *awaClient, LibObjectsContext *context, AwaObjectID objectID,
+    AwaObjectInstanceID objectInstanceID, IPSOSensorInstance *instance, LibObjectsTime now)
+{
+    uint8_t dirty = LIBOBJECTS_TAKE_BITS(&instance->Dirty);
+    uint8_t due = 0;
+    int i;
+
+    for (i = 0; i < IPSO_SENSOR_DIRTY_RESOURCES; i++)
+    {
+        LibObjectsTime elapsed = now - instance->NotifiedTime[i];
+        if ((dirty & (1 << i)) ? (elapsed >= instance->MinPeriod) : ((instance->MaxPeriod != 0) && (elapsed >= instance->MaxPeriod)))
+        {
+            instance->NotifiedTime[i] = now;
+            due |= 1 << i;
+        }
+    }
+    IPSOSensor_MarkDirty(context, instance, dirty & ~due);
+    return LibObjects_NotifyDirty(awaClient, objectID, objectInstanceID, due, IPSOSensorDirtyResources);
+}
+
+/*
+ * Notifies resources changed by an update now, or marks them dirty for LibObjects_Flush.
+ */
+static AwaError IPSOSensor_Changed(AwaStaticClient *awaClient, LibObjectsContext *context, AwaObjectID objectID,
+    AwaObjectInstanceID objectInstanceID, IPSOSensorInstance *instance, uint8_t dirty)
+{
+#if LIBOBJECTS_DEFERRED_NOTIFY
+    IPSOSensor_MarkDirty(context, instance, dirty);
+    return AwaError_Success;
+#else
+    if ((instance->MinPeriod != 0) || (instance->MaxPeriod != 0))
+    {
+        IPSOSensor_MarkDirty(context, instance, dirty);
+        return IPSOSensor_FlushInstance(awaClient, context, objectID, objectInstanceID, instance, LibObjects_GetTime());
+    }
+    return LibObjects_NotifyDirty(awaClient, objectID, objectInstanceID, dirty, IPSOSensorDirtyResources);
+#endif
+}
+
+static AwaResult IPSOSensor_Handler(AwaStaticClient *client, AwaOperation operation, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID,
+     AwaResourceID resourceID, AwaResourceInstanceID resourceInstanceID, void **dataPointer, size_t *dataSize, bool *changed)
+{
+    AwaResult result = AwaResult_InternalError;
+    LibObjectsContext *context = LibObjects_GetContext(client);
+    IPSOSensor *sensor = IPSOSensor_Find(context, objectID);
+    IPSOSensorInstance *instance;
+    if ((sensor == NULL) || (objectInstanceID < 0) || (objectInstanceID >= sensor->Descriptor->Instances))
+    {
+        printf("Incorrect object data\n");
+        return result;
+    }
+    instance = &sensor->Instances[objectInstanceID];
+
+    switch (operation)
+    {
+        case AwaOperation_CreateResource:
+            result = AwaResult_SuccessCreated;
+            break;
+
+        case AwaOperation_Execute:
+            if (resourceID == IPSO_SENSOR_RESET_MIN_AND_MAX_MEASURED_VALUES)
+            {
+                uint32_t sequence = IPSOSensor_BeginWrite(instance);
+                instance->MinMeasuredValue = instance->Value;
+                instance->MaxMeasuredValue = instance->Value;
+                IPSOSensor_ResetTracking(instance);
+                IPSOSensor_EndWrite(instance, sequence);
+                IPSOSensor_Changed(client, context, objectID, objectInstanceID, instance, IPSO_SENSOR_DIRTY_MIN | IPSO_SENSOR_DIRTY_MAX);
+                result = AwaResult_Success;
+            }
+            else
+            {
+                printf("\n Invalid resource ID for %s execute operation", sensor->Descriptor->Name);
+                result = AwaResult_InternalError;
+            }
+            break;
+
+#if LIBOBJECTS_THREAD_SAFE || IPSO_SENSOR_FIXED_POINT || IPSO_SENSOR_STATISTICS || IPSO_SENSOR_QUANTILES || IPSO_SENSOR_WINDOWS || \
+    IPSO_SENSOR_RECENT_EXTREMES
+        case AwaOperation_Read:
+            result = AwaResult_SuccessContent;
+            *dataSize = sizeof(AwaFloat);
+            switch (resourceID)
+            {
+#if IPSO_SENSOR_RECENT_EXTREMES
+                case IPSO_SENSOR_RECENT_MIN_VALUE:
+                case IPSO_SENSOR_RECENT_MAX_VALUE:
+                    *dataPointer = IPSOSensor_ReadRecent(sensor, instance, resourceID);
+                    break;
+
+                case IPSO_SENSOR_RECENT_PERIOD:
+                    *dataPointer = &instance->RecentPeriod;
+                    *dataSize = sizeof(AwaInteger);
+                    break;
+#endif
+
+#if IPSO_SENSOR_WINDOWS
+                case IPSO_SENSOR_WINDOW_PERIOD:
+                    *dataPointer = &instance->Window.Period;
+                    *dataSize = sizeof(AwaInteger);
+                    break;
+
+                case IPSO_SENSOR_WINDOW_MODE:
+                    *dataPointer = &instance->Window.Mode;
+                    *dataSize = sizeof(AwaInteger);
+                    break;
+
+                case IPSO_SENSOR_WINDOW_FUNCTION:
+                    *dataPointer = &instance->Window.Function;
+                    *dataSize = sizeof(AwaInteger);
+                    break;
+#endif
+
+#if IPSO_SENSOR_STATISTICS
+                case IPSO_SENSOR_MEAN_VALUE:
+                case IPSO_SENSOR_STANDARD_DEVIATION:
+                    *dataPointer = IPSOSensor_ReadStatistic(sensor, instance, resourceID);
+                    break;
+
+                case IPSO_SENSOR_SAMPLE_COUNT:
+                    *dataPointer = IPSOSensor_ReadStatistic(sensor, instance, resourceID);
+                    *dataSize = sizeof(AwaInteger);
+                    break;
+#endif
+
+#if IPSO_SENSOR_QUANTILES
+                case IPSO_SENSOR_PERCENTILE_50:
+                case IPSO_SENSOR_PERCENTILE_95:
+                case IPSO_SENSOR_PERCENTILE_99:
+                    *dataPointer = IPSOSensor_ReadQuantile(sensor, instance, resourceID);
+                    break;
+#endif
+
+#if LIBOBJECTS_THREAD_SAFE || IPSO_SENSOR_FIXED_POINT
+                case IPSO_SENSOR_VALUE:
+                    *dataPointer = IPSOSensor_ReadValue(sensor, instance, &instance->Value);
+                    break;
+
+                case IPSO_SENSOR_MIN_MEASURED_VALUE:
+                    *dataPointer = IPSOSensor_ReadValue(sensor, instance, &instance->MinMeasuredValue);
+                    break;
+
+                case IPSO_SENSOR_MAX_MEASURED_VALUE:
+                    *dataPointer = IPSOSensor_ReadValue(sensor, instance, &instance->MaxMeasuredValue);
+                    break;
+#endif
+
+#if IPSO_SENSOR_FIXED_POINT
+                case IPSO_SENSOR_MIN_RANGE_VALUE:
+                    *dataPointer = IPSOSensor_ReadValue(sensor, instance, &instance->MinRangeValue);
+                    break;
+
+                case IPSO_SENSOR_MAX_RANGE_VALUE:
+                    *dataPointer = IPSOSensor_ReadValue(sensor, instance, &instance->MaxRangeValue);
+                    break;
+#endif
+
+                default:
+                    printf("\n Invalid resource ID for %s read operation", sensor->Descriptor->Name);
+                    result = AwaResult_InternalError;
+                    break;
+            }
+            break;
+#endif
+
+#if IPSO_SENSOR_WINDOWS || IPSO_SENSOR_RECENT_EXTREMES
+        case AwaOperation_Write:
+            if (*dataSize != sizeof(AwaInteger))
+            {
+                result = AwaResult_BadRequest;
+                break;
+            }
+            result = IPSOSensor_Write(context, instance, resourceID, **((AwaInteger **)dataPointer));
+            if (result == AwaResult_SuccessChanged)
+            {
+                *changed = true;
+            }
+            else if (result == AwaResult_InternalError)
+            {
+                printf("\n Invalid resource ID for %s write operation", sensor->Descriptor->Name);
+            }
+            break;
+#endif
+
+        default:
+            printf("%s - unknown operation (%d)\n", sensor->Descriptor->Name, operation);
+            result = AwaResult_SuccessContent;
+            break;
+    }
+    return result;
+}
+
+/*
+ * dataStep is the distance between the resource of two consecutive object instances, 0 if they share it.
+ * Resources without dataPointer are served by IPSOSensor_Handler.
+ */
+static AwaError IPSOSensor_DefineResource(AwaStaticClient *awaClient, AwaObjectID objectID, AwaResourceID resourceID, const char *resourceName,
+    AwaResourceType resourceType, uint16_t minimumInstances, void *dataPointer, size_t dataSize, size_t dataStep)
+{
+    AwaError error = AwaStaticClient_DefineResource(awaClient, objectID, resourceID, resourceName, resourceType, minimumInstances, 1,
+        AwaResourceOperations_ReadOnly);
+    if (dataPointer != NULL)
+    {
+        AwaStaticClient_SetResourceStorageWithPointer(awaClient, objectID, resourceID, dataPointer, dataSize, dataStep);
+    }
+    else
+    {
+        AwaStaticClient_SetResourceOperationHandler(awaClient, objectID, resourceID, IPSOSensor_Handler);
+    }
+    if (error != AwaError_Success)
+    {
+        printf("Failed to define '%s' resource\n", resourceName);
+    }
+    return error;
+}
+
+#if IPSO_SENSOR_WINDOWS || IPSO_SENSOR_RECENT_EXTREMES
+static AwaError IPSOSensor_DefineWritableResource(AwaStaticClient *awaClient, AwaObjectID objectID, AwaResourceID resourceID,
+    const char *resourceName)
+{
+    AwaError error = AwaStaticClient_DefineResource(awaClient, objectID, resourceID, resourceName, AwaResourceType_Integer, 0, 1,
+        AwaResourceOperations_ReadWrite);
+    AwaStaticClient_SetResourceOperationHandler(awaClient, objectID, resourceID, IPSOSensor_Handler);
+    if (error != AwaError_Success)
+    {
+        printf("Failed to define '%s' resource\n", resourceName);
+    }
+    return error;
+}
+#endif
+
+static AwaError IPSOSensor_CreateResource(AwaStaticClient *awaClient, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID,
+    AwaResourceID resourceID, const char *resourceName)
+{
+    AwaError error = AwaStaticClient_CreateResource(awaClient, objectID, objectInstanceID, resourceID);
+    if (error != AwaError_Success)
+    {
+        printf("Failed to create resource '%s'\n", resourceName);
+    }
+    return error;
+}
+
+AwaError IPSOSensor_DefineObjectsAndResources(AwaStaticClient *awaClient, const IPSOSensorDescriptor *descriptor, AwaFloat minRange,
+    AwaFloat maxRange, const char *applicationType)
+{
+    IPSOSensor *sensor;
+    AwaObjectID objectID;
+    AwaObjectInstanceID instance;
+    AwaError error;
+#if IPSO_SENSOR_QUANTILES
+    int i;
+#endif
+
+    if ((awaClient == NULL) || (descriptor == NULL) || (descriptor->Instances <= 0))
+    {
+        printf("Invalid arguments passed to %s", __func__);
+        return AwaError_Unspecified;
+    }
+
+    sensor = IPSOSensor_Allocate(LibObjects_GetContext(awaClient), descriptor);
+    if (sensor == NULL)
+    {
+        printf("No room for %s sensor, increase IPSO_SENSOR_OBJECTS or IPSO_SENSOR_INSTANCES\n", descriptor->Name);
+        return AwaError_OutOfMemory;
+    }
+    objectID = descriptor->ObjectID;
+    for (instance = 0; instance < descriptor->Instances; instance++)
+    {
+        sensor->Instances[instance].MaxRangeValue = IPSOSensor_FromFloat(sensor, maxRange);
+        sensor->Instances[instance].MinRangeValue = IPSOSensor_FromFloat(sensor, minRange);
+    }
+    if (descriptor->ApplicationType != NULL)
+    {
+        const char *type = (applicationType != NULL) ? applicationType : descriptor->ApplicationType;
+        LIBOBJECTS_STRING_STORE(&sensor->ApplicationType, type, strnlen(type, sizeof(sensor->ApplicationType.Value) - 1));
+    }
+
+    error = AwaStaticClient_DefineObject(awaClient, objectID, descriptor->Name, 0, descriptor->Instances);
+    if (error != AwaError_Success)
+    {
+        printf("Failed to register %s IPSO object\n", descriptor->Name);
+        return error;
+    }
+
+    error = IPSOSensor_DefineResource(awaClient, objectID, IPSO_SENSOR_VALUE, "Sensor Value", AwaResourceType_Float, 1,
+        IPSO_SENSOR_LOCKED_STORAGE(&sensor->Instances[0].Value), sizeof(AwaFloat), sizeof(IPSOSensorInstance));
+    if (error != AwaError_Success)
+    {
+        return error;
+    }
+
+    error = IPSOSensor_DefineResource(awaClient, objectID, IPSO_SENSOR_UNITS, "Units", AwaResourceType_String, 0,
+        (void *)descriptor->Units, strlen(descriptor->Units), 0);
+    if (error != AwaError_Success)
+    {
+        return error;
+    }
+
+    error = IPSOSensor_DefineResource(awaClient, objectID, IPSO_SENSOR_MIN_MEASURED_VALUE, "Min Measured Value", AwaResourceType_Float, 0,
+        IPSO_SENSOR_LOCKED_STORAGE(&sensor->Instances[0].MinMeasuredValue), sizeof(AwaFloat), sizeof(IPSOSensorInstance));
+    if (error != AwaError_Success)
+    {
+        return error;
+    }
+
+    error = IPSOSensor_DefineResource(awaClient, objectID, IPSO_SENSOR_MAX_MEASURED_VALUE, "Max Measured Value", AwaResourceType_Float, 0,
+        IPSO_SENSOR_LOCKED_STORAGE(&sensor->Instances[0].MaxMeasuredValue), sizeof(AwaFloat), sizeof(IPSOSensorInstance));
+    if (error != AwaError_Success)
+    {
+        return error;
+    }
+
+    error = IPSOSensor_DefineResource(awaClient, objectID, IPSO_SENSOR_MIN_RANGE_VALUE, "Min Range Value", AwaResourceType_Float, 0,
+        IPSO_SENSOR_FLOAT_STORAGE(&sensor->Instances[0].MinRangeValue), sizeof(AwaFloat), sizeof(IPSOSensorInstance));
+    if (error != AwaError_Success)
+    {
+        return error;
+    }
+
+    error = IPSOSensor_DefineResource(awaClient, objectID, IPSO_SENSOR_MAX_RANGE_VALUE, "Max Range Value", AwaResourceType_Float, 0,
+        IPSO_SENSOR_FLOAT_STORAGE(&sensor->Instances[0].MaxRangeValue), sizeof(AwaFloat), sizeof(IPSOSensorInstance));
+    if (error != AwaError_Success)
+    {
+        return error;
+    }
+
+    error = AwaStaticClient_DefineResource(awaClient, objectID, IPSO_SENSOR_RESET_MIN_AND_MAX_MEASURED_VALUES,
+        "Reset Min and Max Measured Values", AwaResourceType_Opaque, 0, 1, AwaResourceOperations_Execute);
+    AwaStaticClient_SetResourceOperationHandler(awaClient, objectID, IPSO_SENSOR_RESET_MIN_AND_MAX_MEASURED_VALUES, IPSOSensor_Handler);
+    if (error != AwaError_Success)
+    {
+        printf("Failed to define 'Reset Min and Max Measured Values' resource\n");
+        return error;
+    }
+
+    if (descriptor->ApplicationType != NULL)
+    {
+        error = IPSOSensor_DefineResource(awaClient, objectID, IPSO_SENSOR_APPLICATION_TYPE, "Application type", AwaResourceType_String, 0,
+            (void *)sensor->ApplicationType.Value, sensor->ApplicationType.Length, 0);
+        if (error != AwaError_Success)
+        {
+            return error;
+        }
+    }
+
+#if IPSO_SENSOR_STATISTICS
+    if (((error = IPSOSensor_DefineResource(awaClient, objectID, IPSO_SENSOR_MEAN_VALUE, "Mean Value", AwaResourceType_Float, 0,
+            NULL, 0, 0)) != AwaError_Success) ||
+        ((error = IPSOSensor_DefineResource(awaClient, objectID, IPSO_SENSOR_STANDARD_DEVIATION, "Standard Deviation", AwaResourceType_Float, 0,
+            NULL, 0, 0)) != AwaError_Success) ||
+        ((error = IPSOSensor_DefineResource(awaClient, objectID, IPSO_SENSOR_SAMPLE_COUNT, "Sample Count", AwaResourceType_Integer, 0,
+            NULL, 0, 0)) != AwaError_Success))
+    {
+        return error;
+    }
+#endif
+
+#if IPSO_SENSOR_RECENT_EXTREMES
+    if (((error = IPSOSensor_DefineResource(awaClient, objectID, IPSO_SENSOR_RECENT_MIN_VALUE, "Recent Min Value", AwaResourceType_Float, 0,
+            NULL, 0, 0)) != AwaError_Success) ||
+        ((error = IPSOSensor_DefineResource(awaClient, objectID, IPSO_SENSOR_RECENT_MAX_VALUE, "Recent Max Value", AwaResourceType_Float, 0,
+            NULL, 0, 0)) != AwaError_Success) ||
+        ((error = IPSOSensor_DefineWritableResource(awaClient, objectID, IPSO_SENSOR_RECENT_PERIOD, "Recent Period")) != AwaError_Success))
+    {
+        return error;
+    }
+#endif
+
+#if IPSO_SENSOR_WINDOWS
+    if (((error = IPSOSensor_DefineWritableResource(awaClient, objectID, IPSO_SENSOR_WINDOW_PERIOD, "Window Period")) != AwaError_Success) ||
+        ((error = IPSOSensor_DefineWritableResource(awaClient, objectID, IPSO_SENSOR_WINDOW_MODE, "Window Mode")) != AwaError_Success) ||
+        ((error = IPSOSensor_DefineWritableResource(awaClient, objectID, IPSO_SENSOR_WINDOW_FUNCTION, "Window Function")) != AwaError_Success))
+    {
+        return error;
+    }
+#endif
+
+#if IPSO_SENSOR_QUANTILES
+    for (i = 0; i < IPSO_SENSOR_QUANTILE_COUNT; i++)
+    {
+        error = IPSOSensor_DefineResource(awaClient, objectID, IPSOSensorQuantileResources[i], IPSOSensorQuantileNames[i],
+            AwaResourceType_Float, 0, NULL, 0, 0);
+        if (error != AwaError_Success)
+        {
+            return error;
+        }
+    }
+#endif
+
+    for (instance = 0; instance < descriptor->Instances; instance++)
+    {
+        error = AwaStaticClient_CreateObjectInstance(awaClient, objectID, instance);
+        if (error != AwaError_Success) {
+            // if the object instance already exists,
+            // the object already contains a maximum number of object instances,
+            // or if no object is defined for the specified object ID.
+            printf("Failed to CreateObjectInstance\n");
+            return error;
+        }
+
+        //Since it's mandatory resource, you don't need to create it explicit. Awa will handle this for you
+        //error = AwaStaticClient_CreateResource(awaClient, objectID, instance, IPSO_SENSOR_VALUE);
+        if (((error = IPSOSensor_CreateResource(awaClient, objectID, instance, IPSO_SENSOR_UNITS, "Units")) != AwaError_Success) ||
+            ((error = IPSOSensor_CreateResource(awaClient, objectID, instance, IPSO_SENSOR_MAX_RANGE_VALUE, "Max Range Value")) != AwaError_Success) ||
+            ((error = IPSOSensor_CreateResource(awaClient, objectID, instance, IPSO_SENSOR_MIN_RANGE_VALUE, "Min Range Value")) != AwaError_Success) ||
+            ((error = IPSOSensor_CreateResource(awaClient, objectID, instance, IPSO_SENSOR_MIN_MEASURED_VALUE, "Min Measured Value")) != AwaError_Success) ||
+            ((error = IPSOSensor_CreateResource(awaClient, objectID, instance, IPSO_SENSOR_MAX_MEASURED_VALUE, "Max Measured Value")) != AwaError_Success) ||
+            ((error = IPSOSensor_CreateResource(awaClient, objectID, instance, IPSO_SENSOR_RESET_MIN_AND_MAX_MEASURED_VALUES,
+                "Reset Min and Max Measured Values")) != AwaError_Success))
+        {
+            return error;
+        }
+
+        if (descriptor->ApplicationType != NULL)
+        {
+            error = IPSOSensor_CreateResource(awaClient, objectID, instance, IPSO_SENSOR_APPLICATION_TYPE, "Application Type");
+            if (error != AwaError_Success)
+            {
+                return error;
+            }
+        }
+
+#if IPSO_SENSOR_STATISTICS
+        if (((error = IPSOSensor_CreateResource(awaClient, objectID, instance, IPSO_SENSOR_MEAN_VALUE, "Mean Value")) != AwaError_Success) ||
+            ((error = IPSOSensor_CreateResource(awaClient, objectID, instance, IPSO_SENSOR_STANDARD_DEVIATION, "Standard Deviation")) != AwaError_Success) ||
+            ((error = IPSOSensor_CreateResource(awaClient, objectID, instance, IPSO_SENSOR_SAMPLE_COUNT, "Sample Count")) != AwaError_Success))
+        {
+            return error;
+        }
+#endif
+
+#if IPSO_SENSOR_RECENT_EXTREMES
+        if (((error = IPSOSensor_CreateResource(awaClient, objectID, instance, IPSO_SENSOR_RECENT_MIN_VALUE, "Recent Min Value")) != AwaError_Success) ||
+            ((error = IPSOSensor_CreateResource(awaClient, objectID, instance, IPSO_SENSOR_RECENT_MAX_VALUE, "Recent Max Value")) != AwaError_Success) ||
+            ((error = IPSOSensor_CreateResource(awaClient, objectID, instance, IPSO_SENSOR_RECENT_PERIOD, "Recent Period")) != AwaError_Success))
+        {
+            return error;
+        }
+#endif
+
+#if IPSO_SENSOR_WINDOWS
+        if (((error = IPSOSensor_CreateResource(awaClient, objectID, instance, IPSO_SENSOR_WINDOW_PERIOD, "Window Period")) != AwaError_Success) ||
+            ((error = IPSOSensor_CreateResource(awaClient, objectID, instance, IPSO_SENSOR_WINDOW_MODE, "Window Mode")) != AwaError_Success) ||
+            ((error = IPSOSensor_CreateResource(awaClient, objectID, instance, IPSO_SENSOR_WINDOW_FUNCTION, "Window Function")) != AwaError_Success))
+        {
+            return error;
+        }
+#endif
+
+#if IPSO_SENSOR_QUANTILES
+        for (i = 0; i < IPSO_SENSOR_QUANTILE_COUNT; i++)
+        {
+            error = IPSOSensor_CreateResource(awaClient, objectID, instance, IPSOSensorQuantileResources[i], IPSOSensorQuantileNames[i]);
+            if (error != AwaError_Success)
+            {
+                return error;
+            }
+        }
+#endif
+    }
+    return AwaError_Success;
+}
+
+AwaError IPSOSensor_SetValue(AwaStaticClient *awaClient, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaFloat value)
+{
+    LibObjectsContext *context = LibObjects_GetContext(awaClient);
+    IPSOSensor *sensor = IPSOSensor_Find(context, objectID);
+    IPSOSensorInstance *instance = IPSOSensor_GetInstance(sensor, objectInstanceID);
+    if ((awaClient != NULL) && (instance != NULL))
+    {
+        return IPSOSensor_Changed(awaClient, context, objectID, objectInstanceID, instance,
+            IPSOSensor_Update(instance, IPSOSensor_FromFloat(sensor, value)));
+    }
+    else
+    {
+        printf("Invalid arguments passed to %s", __func__);
+        return AwaError_Unspecified;
+    }
+}
+
+AwaError IPSOSensor_SetDeadband(AwaStaticClient *awaClient, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID,
+    AwaFloat absoluteDeadband, AwaFloat relativeDeadband)
+{
+    IPSOSensor *sensor = IPSOSensor_Find(LibObjects_GetContext(awaClient), objectID);
+    IPSOSensorInstance *instance = IPSOSensor_GetInstance(sensor, objectInstanceID);
+    if ((awaClient != NULL) && (instance != NULL) && (absoluteDeadband >= 0) && (relativeDeadband >= 0))
+    {
+        uint32_t sequence = IPSOSensor_BeginWrite(instance);
+        instance->AbsoluteDeadband = IPSOSensor_FromFloat(sensor, absoluteDeadband);
+#if IPSO_SENSOR_FIXED_POINT
+        instance->RelativeDeadband = relativeDeadband * (1 << IPSO_SENSOR_FRACTION_BITS) + 0.5;
+#else
+        instance->RelativeDeadband = relativeDeadband;
+#endif
+        IPSOSensor_EndWrite(instance, sequence);
+        return AwaError_Success;
+    }
+    else
+    {
+        printf("Invalid arguments passed to %s", __func__);
+        return AwaError_Unspecified;
+    }
+}
+
+AwaError IPSOSensor_SetNotificationPeriods(AwaStaticClient *awaClient, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID,
+    uint32_t minPeriod, uint32_t maxPeriod)
+{
+    LibObjectsContext *context = LibObjects_GetContext(awaClient);
+    IPSOSensorInstance *instance = IPSOSensor_FindInstance(context, objectID, objectInstanceID);
+    if ((awaClient != NULL) && (instance != NULL) && ((maxPeriod == 0) || (maxPeriod >= minPeriod)))
+    {
+        instance->MinPeriod = minPeriod;
+        instance->MaxPeriod = maxPeriod;
+        IPSOSensor_Schedule(context, instance);
+        return AwaError_Success;
+    }
+    else
+    {
+        printf("Invalid arguments passed to %s", __func__);
+        return AwaError_Unspecified;
+    }
+}
+
+AwaError IPSOSensor_SetValueBatch(AwaStaticClient *awaClient, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID,
+    const AwaFloat *samples, size_t count)
+{
+    LibObjectsContext *context = LibObjects_GetContext(awaClient);
+    IPSOSensor *sensor = IPSOSensor_Find(context, objectID);
+    IPSOSensorInstance *instance = IPSOSensor_GetInstance(sensor, objectInstanceID);
+    if ((awaClient != NULL) && (instance != NULL) && (samples != NULL) && (count > 0))
+    {
+#if IPSO_SENSOR_FIXED_POINT
+        IPSOSensorValue converted[IPSO_SENSOR_CONVERSION_CHUNK];
+        uint8_t changed = 0;
+        size_t done;
+        for (done = 0; done < count; done += IPSO_SENSOR_CONVERSION_CHUNK)
+        {
+            size_t chunk = (count - done < IPSO_SENSOR_CONVERSION_CHUNK) ? count - done : IPSO_SENSOR_CONVERSION_CHUNK;
+            size_t i;
+            for (i = 0; i < chunk; i++)
+            {
+                converted[i] = IPSOSensor_FromFloat(sensor, samples[done + i]);
+            }
+            changed |= IPSOSensor_UpdateBatch(instance, converted, chunk);
+        }
+        return IPSOSensor_Changed(awaClient, context, objectID, objectInstanceID, instance, changed);
+#else
+        return IPSOSensor_Changed(awaClient, context, objectID, objectInstanceID, instance,
+            IPSOSensor_UpdateBatch(instance, samples, count));
+#endif
+    }
+    else
+    {
+        printf("Invalid arguments passed to %s", __func__);
+        return AwaError_Unspecified;
+    }
+}
+
+#if IPSO_SENSOR_FIXED_POINT
+
+AwaError IPSOSensor_SetFixedValue(AwaStaticClient *awaClient, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, int32_t value)
+{
+    LibObjectsContext *context = LibObjects_GetContext(awaClient);
+    IPSOSensorInstance *instance = IPSOSensor_FindInstance(context, objectID, objectInstanceID);
+    if ((awaClient != NULL) && (instance != NULL))
+    {
+        return IPSOSensor_Changed(awaClient, context, objectID, objectInstanceID, instance, IPSOSensor_Update(instance, value));
+    }
+    else
+    {
+        printf("Invalid arguments passed to %s", __func__);
+        return AwaError_Unspecified;
+    }
+}
+
+AwaError IPSOSensor_SetFixedValueBatch(AwaStaticClient *awaClient, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID,
+    const int32_t *samples, size_t count)
+{
+    LibObjectsContext *context = LibObjects_GetContext(awaClient);
+    IPSOSensorInstance *instance = IPSOSensor_FindInstance(context, objectID, objectInstanceID);
+    if ((awaClient != NULL) && (instance != NULL) && (samples != NULL) && (count > 0))
+    {
+        return IPSOSensor_Changed(awaClient, context, objectID, objectInstanceID, instance,
+            IPSOSensor_UpdateBatch(instance, samples, count));
+    }
+    else
+    {
+        printf("Invalid arguments passed to %s", __func__);
+        return AwaError_Unspecified;
+    }
+}
+
+#endif /* IPSO_SENSOR_FIXED_POINT */
+
+#if IPSO_SENSOR_WINDOWS
+
+AwaError IPSOSensor_SetWindow(AwaStaticClient *awaClient, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID,
+    AwaInteger period, AwaInteger mode, AwaInteger function)
+{
+    LibObjectsContext *context = LibObjects_GetContext(awaClient);
+    IPSOSensorInstance *instance = IPSOSensor_FindInstance(context, objectID, objectInstanceID);
+    if ((awaClient != NULL) && (instance != NULL) && IPSOSensor_ConfigureWindow(context, instance, period, mode, function))
+    {
+        return AwaError_Success;
+    }
+    else
+    {
+        printf("Invalid arguments passed to %s", __func__);
+        return AwaError_Unspecified;
+    }
+}
+
+#endif /* IPSO_SENSOR_WINDOWS */
+
+#if IPSO_SENSOR_RECENT_EXTREMES
+
+AwaError IPSOSensor_SetRecentPeriod(AwaStaticClient *awaClient, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID,
+    AwaInteger period)
+{
+    IPSOSensorInstance *instance = IPSOSensor_FindInstance(LibObjects_GetContext(awaClient), objectID, objectInstanceID);
+    if ((awaClient != NULL) && (instance != NULL) && IPSOSensor_ConfigureRecent(instance, period))
+    {
+        return AwaError_Success;
+    }
+    else
+    {
+        printf("Invalid arguments passed to %s", __func__);
+        return AwaError_Unspecified;
+    }
+}
+
+#endif /* IPSO_SENSOR_RECENT_EXTREMES */
+
+#if LIBOBJECTS_RING_SIZE > 0
+
+AwaError IPSOSensor_PushValue(AwaStaticClient *awaClient, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaFloat value)
+{
+    IPSOSensor *sensor = IPSOSensor_Find(LibObjects_GetContext(awaClient), objectID);
+    uint32_t head;
+
+    if ((awaClient == NULL) || (sensor == NULL) || (objectInstanceID < 0) || (objectInstanceID >= sensor->Descriptor->Instances))
+    {
+        printf("Invalid arguments passed to %s", __func__);
+        return AwaError_Unspecified;
+    }
+    if (!LibObjectsRing_Reserve(&sensor->Ring, &head))
+    {
+        return AwaError_OutOfMemory;
+    }
+    sensor->Samples[LIBOBJECTS_RING_SLOT(head)].Instance = objectInstanceID;
+    sensor->Samples[LIBOBJECTS_RING_SLOT(head)].Value = IPSOSensor_FromFloat(sensor, value);
+    LibObjectsRing_Commit(&sensor->Ring, head);
+    return AwaError_Success;
+}
+
+void IPSOSensor_Drain(AwaStaticClient *awaClient, LibObjectsContext *context)
+{
+    int i;
+    for (i = 0; i < IPSO_SENSOR_OBJECTS; i++)
+    {
+        IPSOSensor *sensor = &context->Sensors[i];
+        uint32_t tail;
+        uint32_t head;
+
+        if (sensor->Descriptor == NULL)
+        {
+            continue;
+        }
+        head = LibObjectsRing_Peek(&sensor->Ring, &tail);
+        for (; tail != head; tail++)
+        {
+            IPSOSensorSample *sample = &sensor->Samples[LIBOBJECTS_RING_SLOT(tail)];
+            IPSOSensorInstance *instance = &sensor->Instances[sample->Instance];
+            IPSOSensor_MarkDirty(context, instance, IPSOSensor_Update(instance, sample->Value));
+        }
+        LibObjectsRing_Release(&sensor->Ring, tail);
+    }
+}
+
+#endif /* LIBOBJECTS_RING_SIZE > 0 */
+
+void IPSOSensor_Flush(AwaStaticClient *awaClient, LibObjectsContext *context)
+{
+    LibObjectsTime now = LibObjects_GetTime();
+    size_t word;
+    for (word = 0; word < LIBOBJECTS_BITMAP_WORDS(IPSO_SENSOR_INSTANCES); word++)
+    {
+        uint32_t pending = LIBOBJECTS_TAKE_BITS(&context->SensorInstancesDirty[word]) | context->SensorInstancesScheduled[word];
+        while (pending != 0)
+        {
+            size_t slot = word * 32 + __builtin_ctz(pending);
+            IPSOSensorInstance *instance = &context->SensorInstances[slot];
+            int i;
+            pending &= pending - 1;
+
+            for (i = 0; i < IPSO_SENSOR_OBJECTS; i++)
+            {
+                IPSOSensor *sensor = &context->Sensors[i];
+                if ((sensor->Descriptor != NULL) && (instance >= sensor->Instances) &&
+                    (instance < sensor->Instances + sensor->Descriptor->Instances))
+                {
+#if IPSO_SENSOR_WINDOWS
+                    IPSOSensor_CloseWindow(context, instance, now);
+#endif
+                    IPSOSensor_FlushInstance(awaClient, context, sensor->Descriptor->ObjectID, instance - sensor->Instances, instance, now);
+                    break;
+                }
+            }
+        }
+    }
+}
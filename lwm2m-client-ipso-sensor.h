@@ -0,0 +1,309 @@
+/**
+ * @file
+ * LightWeightM2M LWM2M generic IPSO sensor object.
+ *
+ * @author Imagination Technologies
+ *
+ * @copyright Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group
+ * companies and/or licensors.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LWM2M_CLIENT_IPSO_SENSOR_H_
+#define LWM2M_CLIENT_IPSO_SENSOR_H_
+
+#include "awa/static.h"
+#include "lwm2m-client-libobjects.h"
+
+/***************************************************************************************************
+ * Macros
+ **************************************************************************************************/
+
+#define IPSO_SENSOR_VALUE                           5700
+#define IPSO_SENSOR_UNITS                           5701
+#define IPSO_SENSOR_MIN_MEASURED_VALUE              5601
+#define IPSO_SENSOR_MAX_MEASURED_VALUE              5602
+#define IPSO_SENSOR_MIN_RANGE_VALUE                 5603
+#define IPSO_SENSOR_MAX_RANGE_VALUE                 5604
+#define IPSO_SENSOR_RESET_MIN_AND_MAX_MEASURED_VALUES   5605
+#define IPSO_SENSOR_APPLICATION_TYPE                5750
+
+/* Vendor specific resources, only defined when enabled below */
+#define IPSO_SENSOR_MEAN_VALUE                      26241
+#define IPSO_SENSOR_STANDARD_DEVIATION              26242
+#define IPSO_SENSOR_SAMPLE_COUNT                    26243
+#define IPSO_SENSOR_PERCENTILE_50                   26244
+#define IPSO_SENSOR_PERCENTILE_95                   26245
+#define IPSO_SENSOR_PERCENTILE_99                   26246
+#define IPSO_SENSOR_WINDOW_PERIOD                   26247
+#define IPSO_SENSOR_WINDOW_MODE                     26248
+#define IPSO_SENSOR_WINDOW_FUNCTION                 26249
+#define IPSO_SENSOR_RECENT_MIN_VALUE                26250
+#define IPSO_SENSOR_RECENT_MAX_VALUE                26251
+#define IPSO_SENSOR_RECENT_PERIOD                   26252
+
+/* Values of Window Mode */
+#define IPSO_SENSOR_WINDOW_TUMBLING                 0
+#define IPSO_SENSOR_WINDOW_SLIDING                  1
+
+/* Values of Window Function, the aggregate published as Sensor Value */
+#define IPSO_SENSOR_WINDOW_LAST                     0
+#define IPSO_SENSOR_WINDOW_MEAN                     1
+#define IPSO_SENSOR_WINDOW_MIN                      2
+#define IPSO_SENSOR_WINDOW_MAX                      3
+
+#ifndef IPSO_SENSOR_OBJECTS
+#define IPSO_SENSOR_OBJECTS                         6
+#endif
+
+/* Capacity of the Application Type kept by every sensor object, longer strings are truncated */
+#ifndef IPSO_SENSOR_APPLICATION_TYPE_SIZE
+#define IPSO_SENSOR_APPLICATION_TYPE_SIZE           100
+#endif
+
+/* Instances shared by all sensor objects, must cover the sum of IPSOSensorDescriptor.Instances */
+#ifndef IPSO_SENSOR_INSTANCES
+#define IPSO_SENSOR_INSTANCES                       (TEMPERATURE_SENSORS + HUMIDITY_SENSORS + BAROMETER_SENSORS + \
+                                                     CONCENTRATION_SENSORS + DISTANCE_SENSORS + POWER_SENSORS)
+#endif
+
+/*
+ * Non-zero keeps running statistics of every sensor instance and exposes Mean Value, Standard Deviation and Sample
+ * Count resources. They cover all samples since the instance was defined or Min/Max Measured Values were last reset.
+ */
+#ifndef IPSO_SENSOR_STATISTICS
+#define IPSO_SENSOR_STATISTICS                      0
+#endif
+
+/*
+ * Non-zero estimates the 50th, 95th and 99th percentile of every sensor instance with P² sketches of constant size,
+ * exposed as Percentile resources and restarted with Min/Max Measured Values.
+ */
+#ifndef IPSO_SENSOR_QUANTILES
+#define IPSO_SENSOR_QUANTILES                       0
+#endif
+
+/*
+ * Non-zero adds a window stage in front of the storage of every sensor instance, configured with the writable Window
+ * Period, Window Mode and Window Function resources or IPSOSensor_SetWindow. Samples are aggregated over the window
+ * and only the result becomes Sensor Value, so Min/Max Measured Values and the statistics see window results too.
+ */
+#ifndef IPSO_SENSOR_WINDOWS
+#define IPSO_SENSOR_WINDOWS                         0
+#endif
+
+/* Number of slices of a sliding window, a result covering the whole window is published at the end of each slice */
+#ifndef IPSO_SENSOR_WINDOW_SLICES
+#define IPSO_SENSOR_WINDOW_SLICES                   6
+#endif
+
+/*
+ * Non-zero tracks the extremes of every sensor instance over the last Recent Period milliseconds, exposed as Recent Min
+ * Value and Recent Max Value next to the all-time Min/Max Measured Values.
+ */
+#ifndef IPSO_SENSOR_RECENT_EXTREMES
+#define IPSO_SENSOR_RECENT_EXTREMES                 0
+#endif
+
+/*
+ * Time resolution of the recent extremes as a fraction of Recent Period. Memory per instance grows with it, a sample
+ * may be reported up to Recent Period / IPSO_SENSOR_RECENT_SLOTS longer than the period.
+ */
+#ifndef IPSO_SENSOR_RECENT_SLOTS
+#define IPSO_SENSOR_RECENT_SLOTS                    8
+#endif
+
+/*
+ * Non-zero keeps sensor values, ranges, Min/Max Measured Values and deadbands as int32_t in 1 / Scale units of the
+ * sensor (see IPSOSensorDescriptor), for targets without FPU. Values are only converted to AwaFloat when Awa reads
+ * them, IPSOSensor_SetFixedValue and IPSOSensor_SetFixedValueBatch take samples without any floating point. Running
+ * statistics and percentiles still use floating point.
+ */
+#ifndef IPSO_SENSOR_FIXED_POINT
+#define IPSO_SENSOR_FIXED_POINT                     0
+#endif
+
+/***************************************************************************************************
+ * Typedefs
+ **************************************************************************************************/
+
+/**
+ * Constant description of one IPSO sensor object type (Temperature, Humidity, ...). All sensor
+ * objects share the same resource layout, so a new sensor type needs only one of these.
+ */
+typedef struct
+{
+    AwaObjectID ObjectID;
+    const char *Name;
+    const char *Units;
+    const char *ApplicationType;    /* Default Application Type, NULL if the object has no such resource */
+    AwaObjectInstanceID Instances;  /* Number of object instances, created with IDs 0 .. Instances - 1 */
+    int32_t Scale;                  /* Fixed-point values are in 1 / Scale units, 0 stands for 1 */
+} IPSOSensorDescriptor;
+
+/***************************************************************************************************
+ * Functions
+ **************************************************************************************************/
+
+/**
+ * @brief Define IPSO sensor object described by descriptor, all resources bound to it and all of its instances. It also takes min and max
+ *  measurable values as a parameters. Range defined in this way is hardware specific and should be choosen from tech
+ *  specification of used device.
+ * @param awaClient Reference to AWA client handle
+ * @param descriptor Constant description of the sensor object
+ * @param minRange Minimal value which can be measured and represented by this object
+ * @param maxRange Maximal value which can be measured and represented by this object
+ * @param applicationType description of application type for this object, NULL selects the descriptor default. It is copied,
+ *  keeping at most IPSO_SENSOR_APPLICATION_TYPE_SIZE - 1 characters.
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError IPSOSensor_DefineObjectsAndResources(AwaStaticClient *awaClient, const IPSOSensorDescriptor *descriptor, AwaFloat minRange,
+    AwaFloat maxRange, const char *applicationType);
+
+/**
+ * @brief Updates current value of a sensor object instance. Call to this method updates also Min/Max measured values.
+ * @param awaClient Reference to AWA client handle
+ * @param objectID ID of sensor object previously defined with IPSOSensor_DefineObjectsAndResources
+ * @param objectInstanceID ID of the sensor object instance
+ * @param value New value for Sensor Value resource
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError IPSOSensor_SetValue(AwaStaticClient *awaClient, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaFloat value);
+
+/**
+ * @brief Sets deadband of Sensor Value notifications, similar to the LwM2M 'st' attribute. The value is always stored but
+ *  only notified when it differs from the last notified value by at least the larger of absoluteDeadband and
+ *  relativeDeadband * |last notified value|. Both are 0 by default, which notifies every update.
+ * @param awaClient Reference to AWA client handle
+ * @param objectID ID of sensor object previously defined with IPSOSensor_DefineObjectsAndResources
+ * @param objectInstanceID ID of the sensor object instance
+ * @param absoluteDeadband Deadband in units of the sensor, not negative
+ * @param relativeDeadband Deadband as a fraction of the last notified value (0.05 for 5%), not negative
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError IPSOSensor_SetDeadband(AwaStaticClient *awaClient, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID,
+    AwaFloat absoluteDeadband, AwaFloat relativeDeadband);
+
+/**
+ * @brief Limits the rate of notifications of a sensor object instance, similar to the LwM2M pmin/pmax attributes. A
+ *  changed resource is notified at most once per minPeriod, faster updates are folded into the latest value which is
+ *  sent by LibObjects_Flush once the period has passed. With maxPeriod LibObjects_Flush also notifies resources that
+ *  have not been notified for that long. LibObjects_Flush has to be called periodically for limited instances.
+ * @param awaClient Reference to AWA client handle
+ * @param objectID ID of sensor object previously defined with IPSOSensor_DefineObjectsAndResources
+ * @param objectInstanceID ID of the sensor object instance
+ * @param minPeriod Minimal time between two notifications of a resource in milliseconds, 0 for no limit
+ * @param maxPeriod Maximal time between two notifications of a resource in milliseconds, 0 to notify on change only
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError IPSOSensor_SetNotificationPeriods(AwaStaticClient *awaClient, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID,
+    uint32_t minPeriod, uint32_t maxPeriod);
+
+/**
+ * @brief Updates sensor object instance with a block of samples. The last sample becomes the current value, Min/Max measured
+ *  values cover all of them and each changed resource is notified once.
+ * @param awaClient Reference to AWA client handle
+ * @param objectID ID of sensor object previously defined with IPSOSensor_DefineObjectsAndResources
+ * @param objectInstanceID ID of the sensor object instance
+ * @param samples Samples in the order they were taken
+ * @param count Number of samples, at least one
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError IPSOSensor_SetValueBatch(AwaStaticClient *awaClient, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID,
+    const AwaFloat *samples, size_t count);
+
+#if IPSO_SENSOR_FIXED_POINT
+/**
+ * @brief Same as IPSOSensor_SetValue for a value in 1 / Scale units of the sensor, without floating point arithmetic.
+ * @param awaClient Reference to AWA client handle
+ * @param objectID ID of sensor object previously defined with IPSOSensor_DefineObjectsAndResources
+ * @param objectInstanceID ID of the sensor object instance
+ * @param value New value for Sensor Value resource, in 1 / Scale units
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError IPSOSensor_SetFixedValue(AwaStaticClient *awaClient, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, int32_t value);
+
+/**
+ * @brief Same as IPSOSensor_SetValueBatch for samples in 1 / Scale units of the sensor, without floating point arithmetic.
+ * @param awaClient Reference to AWA client handle
+ * @param objectID ID of sensor object previously defined with IPSOSensor_DefineObjectsAndResources
+ * @param objectInstanceID ID of the sensor object instance
+ * @param samples Samples in the order they were taken, in 1 / Scale units
+ * @param count Number of samples, at least one
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError IPSOSensor_SetFixedValueBatch(AwaStaticClient *awaClient, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID,
+    const int32_t *samples, size_t count);
+#endif
+
+#if IPSO_SENSOR_WINDOWS
+/**
+ * @brief Configures the window stage of a sensor object instance, like writing the Window resources. A tumbling window
+ *  publishes one result per period, a sliding one a result covering the last period every period / IPSO_SENSOR_WINDOW_SLICES.
+ *  Windows are closed by the first update or LibObjects_Flush after their end, so LibObjects_Flush has to be called
+ *  periodically for results to be published on time. Samples of the window in progress are dropped.
+ * @param awaClient Reference to AWA client handle
+ * @param objectID ID of sensor object previously defined with IPSOSensor_DefineObjectsAndResources
+ * @param objectInstanceID ID of the sensor object instance
+ * @param period Window length in milliseconds, at least IPSO_SENSOR_WINDOW_SLICES for sliding windows, 0 stores every sample
+ * @param mode IPSO_SENSOR_WINDOW_TUMBLING or IPSO_SENSOR_WINDOW_SLIDING
+ * @param function Aggregate published as Sensor Value, IPSO_SENSOR_WINDOW_LAST, _MEAN, _MIN or _MAX
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError IPSOSensor_SetWindow(AwaStaticClient *awaClient, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID,
+    AwaInteger period, AwaInteger mode, AwaInteger function);
+#endif
+
+#if IPSO_SENSOR_RECENT_EXTREMES
+/**
+ * @brief Sets the period covered by Recent Min Value and Recent Max Value of a sensor object instance, like writing the
+ *  Recent Period resource. Samples taken before the change are forgotten.
+ * @param awaClient Reference to AWA client handle
+ * @param objectID ID of sensor object previously defined with IPSOSensor_DefineObjectsAndResources
+ * @param objectInstanceID ID of the sensor object instance
+ * @param period Period in milliseconds, at least IPSO_SENSOR_RECENT_SLOTS, 0 stops tracking
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError IPSOSensor_SetRecentPeriod(AwaStaticClient *awaClient, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID,
+    AwaInteger period);
+#endif
+
+#if LIBOBJECTS_RING_SIZE > 0
+/**
+ * @brief Queues new value of a sensor object instance, it is applied like IPSOSensor_SetValue by the next LibObjects_Drain.
+ *  Safe to call from one producer thread per sensor object while the Awa thread is processing.
+ * @param awaClient Reference to AWA client handle
+ * @param objectID ID of sensor object previously defined with IPSOSensor_DefineObjectsAndResources
+ * @param objectInstanceID ID of the sensor object instance
+ * @param value New value for Sensor Value resource
+ * @return AwaError_Success if the value was queued, AwaError_OutOfMemory if the queue is full, to map other values please
+ *  refer to AwaError type.
+ */
+AwaError IPSOSensor_PushValue(AwaStaticClient *awaClient, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, AwaFloat value);
+#endif
+
+#endif /* LWM2M_CLIENT_IPSO_SENSOR_H_ */
@@ -39,26 +39,21 @@
 #include <string.h>
 #include <awa/static.h>
 #include "lwm2m-client-ipso-set-point.h"
+#include "lwm2m-client-libobjects-private.h"
 
 /***************************************************************************************************
- * Typedefs
+ * Definitions
  **************************************************************************************************/
-typedef struct
-{
-    AwaFloat Value;
-    char Units[13];
-    char ApplicationType[30];
-    SetPointCallback ValueChangeCallback;
-} IPSOSetPoint;
+
+/* Bits of IPSOSetPoint.Dirty, indices to SetPointDirtyResources */
+#define SET_POINT_DIRTY_VALUE                   (1 << 0)
 
 /***************************************************************************************************
  * Globals
  **************************************************************************************************/
 
-static IPSOSetPoint SetPointStorage = {
-  .Value = 0,
-  .Units = "Celsius deg",
-  .ApplicationType = "Temperature Delta Trigger"
+static const AwaResourceID SetPointDirtyResources[] = {
+    IPSO_SET_POINT_VALUE,
 };
 
 /***************************************************************************************************
@@ -68,6 +63,7 @@ AwaResult SetPointObject_Handler(AwaStaticClient *client, AwaOperation operation
      AwaResourceID resourceID, AwaResourceInstanceID resourceInstanceID, void **dataPointer, size_t *dataSize, bool *changed)
 {
     AwaResult result = AwaResult_InternalError;
+    IPSOSetPoint *setPoint = &LibObjects_GetContext(client)->SetPoint;
     if (objectID != IPSO_SET_POINT_OBJECT)
     {
         printf("Incorrect object data\n");
@@ -88,8 +84,8 @@ AwaResult SetPointObject_Handler(AwaStaticClient *client, AwaOperation operation
             switch (resourceID)
             {
                 case IPSO_SET_POINT_VALUE:
-                    *dataPointer = &SetPointStorage.Value;
-                    *dataSize = sizeof(SetPointStorage.Value);
+                    *dataPointer = &setPoint->Value;
+                    *dataSize = sizeof(setPoint->Value);
                     break;
 
                 default:
@@ -104,10 +100,10 @@ AwaResult SetPointObject_Handler(AwaStaticClient *client, AwaOperation operation
             switch (resourceID)
             {
                 case IPSO_SET_POINT_VALUE:
-                    SetPointStorage.Value = **((AwaFloat **)dataPointer);
+                    setPoint->Value = **((AwaFloat **)dataPointer);
                     *changed = true;
-                    if (SetPointStorage.ValueChangeCallback != NULL) {
-                        SetPointStorage.ValueChangeCallback(SetPointStorage.Value);
+                    if (setPoint->ValueChangeCallback != NULL) {
+                        setPoint->ValueChangeCallback(setPoint->Value);
                     }
                     break;
 
@@ -127,8 +123,9 @@ AwaResult SetPointObject_Handler(AwaStaticClient *client, AwaOperation operation
 
 AwaError SetPointObject_DefineObjectsAndResources(AwaStaticClient *awaClient, SetPointCallback valueChangeCallback)
 {
+    IPSOSetPoint *setPoint = &LibObjects_GetContext(awaClient)->SetPoint;
     AwaError error;
-    SetPointStorage.ValueChangeCallback = valueChangeCallback;
+    setPoint->ValueChangeCallback = valueChangeCallback;
 
     error = AwaStaticClient_DefineObject(awaClient, IPSO_SET_POINT_OBJECT, "Set Point", 0, 1);
     if (error != AwaError_Success)
@@ -148,8 +145,8 @@ AwaError SetPointObject_DefineObjectsAndResources(AwaStaticClient *awaClient, Se
 
     error = AwaStaticClient_DefineResource(awaClient, IPSO_SET_POINT_OBJECT, IPSO_SET_POINT_UNITS, "Units", AwaResourceType_String, 0, 1,
         AwaResourceOperations_ReadOnly);
-    AwaStaticClient_SetResourceStorageWithPointer(awaClient, IPSO_SET_POINT_OBJECT, IPSO_SET_POINT_UNITS, SetPointStorage.Units,
-        strlen(SetPointStorage.Units), 0);
+    AwaStaticClient_SetResourceStorageWithPointer(awaClient, IPSO_SET_POINT_OBJECT, IPSO_SET_POINT_UNITS,
+        LIBOBJECTS_STRING_STORAGE(LIBOBJECTS_STRING_CELSIUS), 0);
     if (error != AwaError_Success)
     {
         printf("Failed to define 'Units' resource\n");
@@ -158,8 +155,8 @@ AwaError SetPointObject_DefineObjectsAndResources(AwaStaticClient *awaClient, Se
 
     error = AwaStaticClient_DefineResource(awaClient, IPSO_SET_POINT_OBJECT, IPSO_SET_POINT_APPLICATION_TYPE, "Application Type",
         AwaResourceType_String, 0, 1, AwaResourceOperations_ReadOnly);
-    AwaStaticClient_SetResourceStorageWithPointer(awaClient, IPSO_SET_POINT_OBJECT, IPSO_SET_POINT_APPLICATION_TYPE, SetPointStorage.ApplicationType,
-        strlen(SetPointStorage.ApplicationType), 0);
+    AwaStaticClient_SetResourceStorageWithPointer(awaClient, IPSO_SET_POINT_OBJECT, IPSO_SET_POINT_APPLICATION_TYPE,
+        LIBOBJECTS_STRING_STORAGE(LIBOBJECTS_STRING_TEMPERATURE_DELTA_TRIGGER), 0);
     if (error != AwaError_Success)
     {
         printf("Failed to define 'Application Type' resource\n");
@@ -199,11 +196,16 @@ AwaError SetPointObject_SetValue(AwaStaticClient *awaClient, AwaFloat value)
 {
     if (awaClient != NULL)
     {
+        LibObjectsContext *context = LibObjects_GetContext(awaClient);
+        context->SetPoint.Value = value;
+#if LIBOBJECTS_DEFERRED_NOTIFY
+        LIBOBJECTS_SET_BITS(&context->SetPoint.Dirty, SET_POINT_DIRTY_VALUE);
+        LIBOBJECTS_SET_BITS(&context->DirtyObjects, LIBOBJECTS_DIRTY_SET_POINT);
+        return AwaError_Success;
+#else
         int objectInstanceID = 0;
-        AwaError error;
-        SetPointStorage.Value = value;
-        error = AwaStaticClient_ResourceChanged(awaClient, IPSO_SET_POINT_OBJECT, objectInstanceID, IPSO_SET_POINT_VALUE);
-        return error;
+        return LibObjects_NotifyDirty(awaClient, IPSO_SET_POINT_OBJECT, objectInstanceID, SET_POINT_DIRTY_VALUE, SetPointDirtyResources);
+#endif
     }
     else
     {
@@ -214,5 +216,15 @@ AwaError SetPointObject_SetValue(AwaStaticClient *awaClient, AwaFloat value)
 
 AwaFloat SetPointObject_GetValue()
 {
-    return SetPointStorage.Value;
+    return LibObjects_GetContext(NULL)->SetPoint.Value;
+}
+
+AwaFloat SetPointObject_GetClientValue(AwaStaticClient *awaClient)
+{
+    return LibObjects_GetContext(awaClient)->SetPoint.Value;
+}
+
+void SetPointObject_Flush(AwaStaticClient *awaClient, LibObjectsContext *context)
+{
+    LibObjects_NotifyDirty(awaClient, IPSO_SET_POINT_OBJECT, 0, LIBOBJECTS_TAKE_BITS(&context->SetPoint.Dirty), SetPointDirtyResources);
 }
@@ -73,9 +73,16 @@ AwaError SetPointObject_DefineObjectsAndResources(AwaStaticClient *awaClient, Se
 AwaError SetPointObject_SetValue(AwaStaticClient *awaClient, AwaFloat value);
 
  /**
-  * @brief Reads current value of "Set Point" object resource "Value".
+  * @brief Reads current value of "Set Point" object resource "Value" of the client using the default context.
   * @return Currently stored value in object.
   */
  AwaFloat SetPointObject_GetValue();
 
+ /**
+  * @brief Reads current value of "Set Point" object resource "Value" of given client.
+  * @param awaClient Reference to AWA client handle
+  * @return Currently stored value in object.
+  */
+ AwaFloat SetPointObject_GetClientValue(AwaStaticClient *awaClient);
+
 #endif /* LWM2M_CLIENT_IPSO_SET_POINT_H_ */
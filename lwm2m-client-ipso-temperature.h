@@ -51,13 +51,22 @@
 #define IPSO_TEMPERATURE_MAX_RANGE_VALUE                    5604
 #define IPSO_TEMPERATURE_RESET_MIN_AND_MAX_MEASURED_VALUES  5605
 
+/* Number of Temperature object instances, instance IDs are 0 .. TEMPERATURE_SENSORS - 1 */
+#ifndef TEMPERATURE_SENSORS
+#define TEMPERATURE_SENSORS                                 1
+#endif
+
+/* Units per AwaFloat unit when stored with IPSO_SENSOR_FIXED_POINT, i.e. hundredths of a degree */
+#ifndef TEMPERATURE_FIXED_SCALE
+#define TEMPERATURE_FIXED_SCALE                             100
+#endif
 
 /***************************************************************************************************
  * Functions
  **************************************************************************************************/
 
 /**
- * @brief Define single IPSO Temperature object (with ID 3003) and all resources bound to it. It also takes min and max measurable temperatures as a parameters.
+ * @brief Define IPSO Temperature object (with ID 3003), all resources bound to it and TEMPERATURE_SENSORS instances of it. It also takes min and max measurable temperatures as a parameters.
  *  Range defined in this way is hardware specific and should be choosen from tech specification of used device.
  * @param awaClient Reference to AWA client handle
  * @param minRange Minimal temperature which can be measured and represented by this object
@@ -74,4 +83,24 @@ AwaError TemperatureObject_DefineObjectsAndResources(AwaStaticClient *awaClient,
  */
 AwaError TemperatureObject_SetTemperature(AwaStaticClient *awaClient, AwaFloat temperature);
 
+/**
+ * @brief Updates current value of temperature for one object instance. Call to this method updates also Min/Max measured values
+ *  of that instance.
+ * @param awaClient Reference to AWA client handle
+ * @param objectInstanceID ID of the object instance, between 0 and TEMPERATURE_SENSORS - 1
+ * @param temperature New value for temperature resource (Sensor value)
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError TemperatureObject_SetTemperatureInstance(AwaStaticClient *awaClient, AwaObjectInstanceID objectInstanceID, AwaFloat temperature);
+
+/**
+ * @brief Updates current value of temperature from a block of samples, e.g. one DMA transfer. The last sample becomes the current
+ *  value, Min/Max measured values cover the whole block and each changed resource is notified once.
+ * @param awaClient Reference to AWA client handle
+ * @param samples Temperature samples in the order they were taken
+ * @param count Number of samples, at least one
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError TemperatureObject_SetTemperatureBatch(AwaStaticClient *awaClient, const AwaFloat *samples, size_t count);
+
 #endif /* LWM2M_CLIENT_IPSO_TEMPERATURE_H_ */
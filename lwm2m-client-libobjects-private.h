@@ -0,0 +1,648 @@
+/**
+ * @file
+ * LightWeightM2M LWM2M libobjects internal definitions.
+ *
+ * @author Imagination Technologies
+ *
+ * @copyright Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group
+ * companies and/or licensors.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LWM2M_CLIENT_LIBOBJECTS_PRIVATE_H_
+#define LWM2M_CLIENT_LIBOBJECTS_PRIVATE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include "awa/static.h"
+#include "lwm2m-client-libobjects.h"
+#include "lwm2m-client-device-object.h"
+#include "lwm2m-client-ipso-digital-input.h"
+#include "lwm2m-client-ipso-light-control.h"
+#include "lwm2m-client-ipso-set-point.h"
+#include "lwm2m-client-ipso-sensor.h"
+#include "lwm2m-client-ipso-temperature.h"
+#include "lwm2m-client-ipso-humidity.h"
+#include "lwm2m-client-ipso-barometer.h"
+#include "lwm2m-client-ipso-concentration.h"
+#include "lwm2m-client-ipso-distance.h"
+#include "lwm2m-client-ipso-power.h"
+
+/***************************************************************************************************
+ * Definitions
+ **************************************************************************************************/
+
+#define LWM2M_DEVICE_OBJECT_POWER_SOURCES_COUNT         7
+#define LWM2M_DEVICE_OBJECT_ERROR_CODE_COUNT            LWM2M_DEVICE_ERROR_CODES
+
+#if (LWM2M_DEVICE_ERROR_CODES < 1) || (LWM2M_DEVICE_ERROR_CODES > 255)
+#error LWM2M_DEVICE_ERROR_CODES must be between 1 and 255
+#endif
+
+/* Device resource values sampled from providers: Memory Free, Memory Total, Current Time, Battery Level and Power Source Voltages */
+#define LWM2M_DEVICE_OBJECT_SAMPLES                     (4 + LWM2M_DEVICE_OBJECT_POWER_SOURCES_COUNT)
+
+#if LIBOBJECTS_RING_SIZE > 0
+#if (LIBOBJECTS_RING_SIZE & (LIBOBJECTS_RING_SIZE - 1)) != 0
+#error LIBOBJECTS_RING_SIZE must be a power of two
+#endif
+#define LIBOBJECTS_RING_SLOT(index)                     ((index) & (LIBOBJECTS_RING_SIZE - 1))
+#endif
+
+#define LIBOBJECTS_CACHE_LINE_SIZE                      64
+
+#define LIBOBJECTS_BITMAP_WORDS(bits)                   (((bits) + 31) / 32)
+
+/* Structure holding member, from a pointer to the member */
+#define LIBOBJECTS_CONTAINER_OF(pointer, structure, member) ((structure *)((char *)(pointer) - offsetof(structure, member)))
+
+/*
+ * Timer wheel: LIBOBJECTS_TIMER_LEVELS levels of 64 slots, a slot of level n spans 64^n ms. Timers further than
+ * 64^LIBOBJECTS_TIMER_LEVELS ms away wait in the last slot of the top level and are moved down as time passes.
+ */
+#define LIBOBJECTS_TIMER_LEVELS                         4
+#define LIBOBJECTS_TIMER_SLOT_BITS                      6
+#define LIBOBJECTS_TIMER_SLOTS                          (1 << LIBOBJECTS_TIMER_SLOT_BITS)
+
+/* Initializer of a LibObjectsString from a literal, and the storage of a pooled string for SetResourceStorageWithPointer */
+#define LIBOBJECTS_STRING(literal)                      { (literal), sizeof(literal) - 1 }
+#define LIBOBJECTS_STRING_STORAGE(id)                   (void *)LibObjectsStrings[(id)].Value, LibObjectsStrings[(id)].Length
+
+/*
+ * Writable string resource of up to size - 1 characters. Its length is kept up to date on writes, so reads are
+ * served as Value and Length without scanning or padding. Value is always NUL terminated.
+ */
+#define LIBOBJECTS_STRING_BUFFER(size)                  struct { uint16_t Length; char Value[(size)]; }
+#define LIBOBJECTS_STRING_STORE(buffer, data, size)     LibObjectsString_Store((buffer)->Value, &(buffer)->Length, sizeof((buffer)->Value), \
+                                                            (data), (size))
+
+/* Bits of LibObjectsResource.Flags */
+#define LIBOBJECTS_RESOURCE_STRING                      (1 << 0)    /* Value is a LIBOBJECTS_STRING_BUFFER */
+#define LIBOBJECTS_RESOURCE_POOLED                      (1 << 1)    /* Offset is a LibObjectsStringID, value is constant */
+
+/* Initializers of LibObjectsResource entries for a field of the instance structure, a string pool entry and an Execute resource */
+#define LIBOBJECTS_RESOURCE(id, name, type, mandatory, operations, structure, field, callback) \
+    { (id), (name), (type), (mandatory), (operations), offsetof(structure, field), sizeof(((structure *)0)->field), 0, (callback) }
+#define LIBOBJECTS_STRING_RESOURCE(id, name, mandatory, operations, structure, field, callback) \
+    { (id), (name), AwaResourceType_String, (mandatory), (operations), offsetof(structure, field), \
+        sizeof(((structure *)0)->field.Value), LIBOBJECTS_RESOURCE_STRING, (callback) }
+#define LIBOBJECTS_POOLED_RESOURCE(id, name, mandatory, stringID) \
+    { (id), (name), AwaResourceType_String, (mandatory), AwaResourceOperations_ReadOnly, (stringID), 0, LIBOBJECTS_RESOURCE_POOLED, NULL }
+#define LIBOBJECTS_EXECUTE_RESOURCE(id, name, callback) \
+    { (id), (name), AwaResourceType_Opaque, false, AwaResourceOperations_Execute, 0, 0, 0, (callback) }
+
+/* Objects with dirty resources, bits of LibObjectsContext.DirtyObjects */
+#define LIBOBJECTS_DIRTY_SENSORS                        (1 << 0)
+#define LIBOBJECTS_DIRTY_DIGITAL_INPUTS                 (1 << 1)
+#define LIBOBJECTS_DIRTY_PRESENCE                       (1 << 2)
+#define LIBOBJECTS_DIRTY_SET_POINT                      (1 << 3)
+#define LIBOBJECTS_DIRTY_DEVICE                         (1 << 4)
+
+/* Number of percentiles estimated per sensor instance, and markers used by each P² sketch */
+#define IPSO_SENSOR_QUANTILE_COUNT                      3
+#define IPSO_SENSOR_QUANTILE_MARKERS                    5
+
+/* Number of IPSOSensorInstance resources tracked by dirty bits */
+#define IPSO_SENSOR_DIRTY_RESOURCES                     3
+
+/*
+ * Dirty bits may be set by any thread updating an object and are taken by LibObjects_Flush. Bits are set on the
+ * instance before its summary bits and taken in the opposite order, so a racing update is at worst flushed twice.
+ */
+#if LIBOBJECTS_THREAD_SAFE
+#define LIBOBJECTS_SET_BITS(pointer, bits)              __atomic_fetch_or((pointer), (bits), __ATOMIC_RELEASE)
+#define LIBOBJECTS_TAKE_BITS(pointer)                   __atomic_exchange_n((pointer), 0, __ATOMIC_ACQUIRE)
+#else
+#define LIBOBJECTS_SET_BITS(pointer, bits)              (*(pointer) |= (bits))
+#define LIBOBJECTS_TAKE_BITS(pointer)                   __atomic_exchange_n((pointer), 0, __ATOMIC_RELAXED)
+#endif
+
+/***************************************************************************************************
+ * Typedefs
+ **************************************************************************************************/
+
+#if IPSO_SENSOR_FIXED_POINT
+/* Sensor values in 1 / IPSOSensorDescriptor.Scale units, sums of them and fractions with 16 fractional bits */
+typedef int32_t IPSOSensorValue;
+typedef int64_t IPSOSensorSum;
+typedef int32_t IPSOSensorFraction;
+#else
+typedef AwaFloat IPSOSensorValue;
+typedef AwaFloat IPSOSensorSum;
+typedef AwaFloat IPSOSensorFraction;
+#endif
+
+/* Constant string referenced by pointer and length, the text itself stays in read-only memory */
+typedef struct
+{
+    const char *Value;
+    size_t Length;
+} LibObjectsString;
+
+/* Indices to LibObjectsStrings. Read-only string resources point there instead of keeping a copy in RAM. */
+typedef enum
+{
+    LIBOBJECTS_STRING_EMPTY,
+    LIBOBJECTS_STRING_CELSIUS,
+    LIBOBJECTS_STRING_TEMPERATURE_DELTA_TRIGGER,
+    LIBOBJECTS_STRING_DEVICE_MANUFACTURER,
+    LIBOBJECTS_STRING_DEVICE_MODEL_NUMBER,
+    LIBOBJECTS_STRING_DEVICE_SERIAL_NUMBER,
+    LIBOBJECTS_STRING_DEVICE_FIRMWARE_VERSION,
+    LIBOBJECTS_STRING_DEVICE_BINDING_AND_MODES,
+    LIBOBJECTS_STRING_DEVICE_TYPE,
+    LIBOBJECTS_STRING_DEVICE_HARDWARE_VERSION,
+    LIBOBJECTS_STRING_DEVICE_SOFTWARE_VERSION,
+    LIBOBJECTS_STRING_DIGITAL_INPUT_APPLICATION_TYPE,
+    LIBOBJECTS_STRING_DIGITAL_INPUT_SENSOR_TYPE,
+    LIBOBJECTS_STRING_LIGHT_CONTROL_UNITS,
+    LIBOBJECTS_STRING_COUNT
+} LibObjectsStringID;
+
+typedef struct _LibObjectsResource LibObjectsResource;
+
+/*
+ * Called before a resource is read, after it was written and when it is executed. AwaResult_Success keeps the result
+ * of the operation, anything else replaces it.
+ */
+typedef AwaResult (*LibObjectsResourceCallback)(AwaStaticClient *awaClient, AwaOperation operation, AwaObjectInstanceID objectInstanceID,
+    void *instance, const LibObjectsResource *resource);
+
+/* Resource of an object served by LibObjects_HandleResource, bound to a field of the instance structure */
+struct _LibObjectsResource
+{
+    AwaResourceID ResourceID;
+    const char *Name;
+    AwaResourceType Type;
+    bool Mandatory;
+    AwaResourceOperations Operations;
+    uint16_t Offset;                /* Of the field in the instance structure, a LibObjectsStringID for pooled strings */
+    uint16_t Size;                  /* Of the field, capacity of the text for LIBOBJECTS_RESOURCE_STRING */
+    uint8_t Flags;                  /* LIBOBJECTS_RESOURCE_* bits */
+    LibObjectsResourceCallback Callback;
+};
+
+/*
+ * Resources of an object. Index maps resourceID - Base to 1 + index to Resources, so a lookup is a bound check and two
+ * loads. Entries of unknown resource IDs are 0.
+ */
+typedef struct
+{
+    AwaObjectID ObjectID;
+    AwaResourceID Base;
+    size_t IndexSize;
+    const uint8_t *Index;
+    const LibObjectsResource *Resources;
+    size_t Count;
+} LibObjectsResourceTable;
+
+typedef struct _LibObjectsTimer LibObjectsTimer;
+
+/**
+ * Called by LibObjects_Tick once the deadline of timer has passed. The timer is no longer scheduled and may be
+ * scheduled again.
+ */
+typedef void (*LibObjectsTimerCallback)(AwaStaticClient *awaClient, LibObjectsContext *context, LibObjectsTimer *timer);
+
+/*
+ * Timer embedded in the object it acts on, see LibObjectsTimer_Schedule. A zeroed timer is not scheduled.
+ */
+struct _LibObjectsTimer
+{
+    LibObjectsTimer *Next;
+    LibObjectsTimer **Previous;     /* Link pointing to this timer, NULL while not scheduled */
+    LibObjectsTime Deadline;
+    LibObjectsTimerCallback Callback;
+    uint8_t Level;
+    uint8_t Slot;
+};
+
+typedef struct
+{
+    LibObjectsTimer *Slots[LIBOBJECTS_TIMER_LEVELS][LIBOBJECTS_TIMER_SLOTS];
+    uint64_t Occupied[LIBOBJECTS_TIMER_LEVELS];    /* Bit per non-empty slot */
+    LibObjectsTime Now;             /* Time up to which timers have been run */
+} LibObjectsTimerWheel;
+
+/*
+ * Counter updated by any number of threads. With LIBOBJECTS_THREAD_SAFE, each thread adds atomically to one of
+ * LIBOBJECTS_COUNTER_SHARDS slots on separate cache lines; the value is their sum less Base, the sum at the last reset.
+ */
+typedef struct
+{
+#if LIBOBJECTS_THREAD_SAFE
+    struct
+    {
+        int64_t Value;
+        char Padding[LIBOBJECTS_CACHE_LINE_SIZE - sizeof(int64_t)];
+    } Shards[LIBOBJECTS_COUNTER_SHARDS];
+#else
+    struct
+    {
+        int64_t Value;
+    } Shards[1];
+#endif
+    int64_t Base;
+} LibObjectsCounter;
+
+#if LIBOBJECTS_RING_SIZE > 0
+/*
+ * Indices of a single-producer single-consumer queue, entries are kept by the owner. Both indices run freely and
+ * are reduced with LIBOBJECTS_RING_SLOT, each one sits on its own cache line.
+ */
+typedef struct
+{
+    uint32_t Head;                  /* Next entry written by the producer */
+    char HeadPadding[LIBOBJECTS_CACHE_LINE_SIZE - sizeof(uint32_t)];
+    uint32_t Tail;                  /* Next entry read by the consumer */
+    char TailPadding[LIBOBJECTS_CACHE_LINE_SIZE - sizeof(uint32_t)];
+} LibObjectsRing;
+
+typedef struct
+{
+    AwaObjectInstanceID Instance;
+    IPSOSensorValue Value;
+} IPSOSensorSample;
+
+typedef struct
+{
+    AwaBoolean State;
+    LibObjectsTime Time;            /* When the state was pushed, delays run from it */
+} IPSOPresenceSample;
+#endif
+
+typedef struct
+{
+    AwaInteger AvailablePowerSources[LWM2M_DEVICE_OBJECT_POWER_SOURCES_COUNT];
+    AwaInteger PowerSourceVoltage[LWM2M_DEVICE_OBJECT_POWER_SOURCES_COUNT];
+    AwaInteger PowerSourceCurrent[LWM2M_DEVICE_OBJECT_POWER_SOURCES_COUNT];
+    AwaInteger BatteryLevel;
+    AwaInteger MemoryFree;
+    AwaInteger ErrorCode[LWM2M_DEVICE_OBJECT_ERROR_CODE_COUNT];    /* Ring of distinct error codes, oldest at FirstErrorCode */
+    uint8_t FirstErrorCode;
+    uint8_t ErrorCodes;             /* Number of codes in ErrorCode, none reads as a single 0 (no error) */
+    uint8_t PowerSources;           /* Number of instances of the power source resources */
+    bool PowerSourcesCreated;       /* Power source resources were created, once PowerSources was first non-zero */
+    uint8_t Dirty;                  /* DEVICE_DIRTY_* bits of resources waiting for LibObjects_Flush */
+    AwaTime CurrentTime;
+    LIBOBJECTS_STRING_BUFFER(16) UTCOffset;
+    LIBOBJECTS_STRING_BUFFER(16) Timezone;
+    AwaInteger BatteryStatus;
+    AwaInteger MemoryTotal;
+    AwaTime TimeOffset;             /* Set by writes of Current Time, added to the sampled time */
+    uint32_t Sampled;               /* Bit per sample of SampleTimes, set while it may be cached */
+    uint32_t Assigned;              /* Bit per sample set by the application, never taken from providers */
+    uint32_t Generation;            /* Provider generation the samples were taken with */
+    LibObjectsTime SampleTimes[LWM2M_DEVICE_OBJECT_SAMPLES];
+} DeviceObject;
+
+typedef struct
+{
+    AwaBoolean State;
+    AwaInteger Counter;             /* Value of Counts last read by Awa */
+    AwaBoolean Polarity;
+    AwaTime DebouncePeriod;
+    AwaInteger EdgeSelection;
+    AwaBoolean Inverted;            /* Polarity State was taken with */
+    bool Pending;                   /* Line has been at the level opposite to State since PendingTime */
+    LibObjectsTime PendingTime;
+    uint8_t Dirty;
+    LibObjectsCounter Counts;
+    LibObjectsTimer DebounceTimer;  /* Accepts the pending level at PendingTime + DebouncePeriod */
+} IPSODigitalInput;
+
+typedef struct
+{
+    AwaBoolean OnOff;
+    AwaInteger Dimmer;
+    LIBOBJECTS_STRING_BUFFER(64) Colour;
+    AwaInteger OnTime;
+    AwaFloat CumulativeActivePower;
+    AwaFloat PowerFactor;
+    LightControlCallBack callback;
+    void *context;
+    AwaFloat RatedPower;            /* Active power in W at full Dimmer */
+    AwaBoolean AccountedOnOff;      /* On/Off and Dimmer in effect since AccountedTime */
+    AwaInteger AccountedDimmer;
+    LibObjectsTime AccountedTime;
+    LibObjectsTime OnMilliseconds;  /* On Time up to AccountedTime */
+} IPSOLightControl;
+
+typedef struct
+{
+    AwaBoolean State;
+    AwaInteger StateCounter;        /* Value of StateCounts last read by Awa */
+    AwaInteger BusyToClearDelay;
+    AwaInteger ClearToBusyDelay;
+    uint8_t Dirty;
+    bool Pending;                   /* Input has been at the opposite of State since DelayTimer was scheduled */
+    LibObjectsCounter StateCounts;
+    LibObjectsTimer DelayTimer;     /* Commits the pending state after Busy to Clear or Clear to Busy delay */
+} IPSOPresence;
+
+typedef struct
+{
+    AwaFloat Value;
+    SetPointCallback ValueChangeCallback;
+    uint8_t Dirty;
+} IPSOSetPoint;
+
+#if IPSO_SENSOR_STATISTICS
+/*
+ * Welford accumulator, O(1) per sample and numerically stable. Standard deviation is only derived from it when read.
+ */
+typedef struct
+{
+    AwaInteger Count;
+    AwaFloat Mean;
+    AwaFloat SquaredDeviations;     /* Sum of squared differences from Mean */
+} IPSOSensorStatistics;
+#endif
+
+#if IPSO_SENSOR_QUANTILES
+/*
+ * P² estimator of one quantile (Jain and Chlamtac). Markers track the minimum, the quantile, the maximum and two
+ * points halfway between them, the middle height is the estimate. Until enough samples were seen Heights holds
+ * them sorted.
+ */
+typedef struct
+{
+    AwaFloat Heights[IPSO_SENSOR_QUANTILE_MARKERS];
+    AwaFloat Desired[IPSO_SENSOR_QUANTILE_MARKERS];     /* Ideal marker positions */
+    int64_t Positions[IPSO_SENSOR_QUANTILE_MARKERS];    /* Actual marker positions, 0 based */
+} IPSOSensorQuantileSketch;
+
+typedef struct
+{
+    uint64_t Count;                 /* 64 bit, like Positions, so they do not wrap at high sample rates */
+    IPSOSensorQuantileSketch Sketches[IPSO_SENSOR_QUANTILE_COUNT];
+} IPSOSensorQuantiles;
+#endif
+
+#if IPSO_SENSOR_WINDOWS
+typedef struct
+{
+    AwaInteger Count;
+    IPSOSensorSum Sum;
+    IPSOSensorValue Min;
+    IPSOSensorValue Max;
+    IPSOSensorValue Last;
+} IPSOSensorWindowSlice;
+
+typedef struct
+{
+    AwaInteger Period;              /* Window length in ms, 0 if samples are stored directly */
+    AwaInteger Mode;                /* IPSO_SENSOR_WINDOW_TUMBLING or IPSO_SENSOR_WINDOW_SLIDING */
+    AwaInteger Function;            /* IPSO_SENSOR_WINDOW_* aggregate published as Sensor Value */
+    LibObjectsTime End;             /* End of the slice receiving samples, 0 until the window is started */
+    uint32_t Current;               /* Slice receiving samples, tumbling windows only use the first one */
+    IPSOSensorWindowSlice Slices[IPSO_SENSOR_WINDOW_SLICES];
+} IPSOSensorWindow;
+#endif
+
+#if IPSO_SENSOR_RECENT_EXTREMES
+typedef struct
+{
+    LibObjectsTime Time;            /* Last time Value was the extreme, it expires Recent Period later */
+    IPSOSensorValue Value;
+} IPSOSensorExtreme;
+
+/*
+ * Monotonic deque of candidate maxima, values decrease from Front to the back. At most one entry is kept per
+ * Recent Period / IPSO_SENSOR_RECENT_SLOTS, which bounds the entries within the period.
+ */
+typedef struct
+{
+    uint32_t Front;
+    uint32_t Count;
+    IPSOSensorExtreme Entries[IPSO_SENSOR_RECENT_SLOTS + 1];
+} IPSOSensorExtremes;
+#endif
+
+typedef struct
+{
+    IPSOSensorValue Value;
+    IPSOSensorValue MinMeasuredValue;
+    IPSOSensorValue MaxMeasuredValue;
+    IPSOSensorValue AbsoluteDeadband;   /* Sensor Value changes smaller than this are not notified */
+    IPSOSensorFraction RelativeDeadband; /* Same as a fraction of NotifiedValue, the larger of both applies */
+    IPSOSensorValue NotifiedValue;  /* Sensor Value of the last notification */
+    IPSOSensorValue MinRangeValue;
+    IPSOSensorValue MaxRangeValue;
+#if LIBOBJECTS_THREAD_SAFE
+    uint32_t Sequence;              /* Odd while Value and Min/Max Measured Value are being updated */
+#endif
+#if LIBOBJECTS_THREAD_SAFE || IPSO_SENSOR_FIXED_POINT
+    AwaFloat Snapshot;              /* Consistent copy of the resource being read by Awa, as AwaFloat */
+#endif
+#if IPSO_SENSOR_STATISTICS
+    IPSOSensorStatistics Statistics;
+#endif
+#if IPSO_SENSOR_QUANTILES
+    IPSOSensorQuantiles Quantiles;
+#endif
+#if IPSO_SENSOR_WINDOWS
+    IPSOSensorWindow Window;
+#endif
+#if IPSO_SENSOR_RECENT_EXTREMES
+    AwaInteger RecentPeriod;        /* Period covered by the recent extremes in ms, 0 if they are not tracked */
+    IPSOSensorExtremes RecentMin;
+    IPSOSensorExtremes RecentMax;
+#endif
+#if IPSO_SENSOR_STATISTICS || IPSO_SENSOR_QUANTILES || IPSO_SENSOR_RECENT_EXTREMES
+    union
+    {
+        AwaFloat Float;
+        AwaInteger Integer;
+    } Statistic;                    /* Statistics resource being read by Awa */
+#endif
+    uint8_t Dirty;                  /* IPSO_SENSOR_DIRTY_* bits of resources waiting for LibObjects_Flush */
+    uint32_t MinPeriod;             /* Minimal time between two notifications of a resource in ms, 0 for no limit */
+    uint32_t MaxPeriod;             /* Resources are notified at least this often in ms, 0 for on change only */
+    LibObjectsTime NotifiedTime[IPSO_SENSOR_DIRTY_RESOURCES];
+} IPSOSensorInstance;
+
+typedef struct
+{
+    const IPSOSensorDescriptor *Descriptor;
+    IPSOSensorInstance *Instances;
+    LIBOBJECTS_STRING_BUFFER(IPSO_SENSOR_APPLICATION_TYPE_SIZE) ApplicationType;  /* Copy of the string passed to IPSOSensor_DefineObjectsAndResources */
+#if LIBOBJECTS_RING_SIZE > 0
+    LibObjectsRing Ring;
+    IPSOSensorSample Samples[LIBOBJECTS_RING_SIZE];
+#endif
+} IPSOSensor;
+
+struct _LibObjectsContext
+{
+    LibObjectsContext *NextFree;
+
+    DeviceObject Device;
+    IPSODigitalInput DigitalInputs[DIGITAL_INPUTS];
+    IPSOLightControl LightControls[LIGHT_CONTROLS];
+    IPSOPresence Presence;
+    IPSOSetPoint SetPoint;
+
+#if LIBOBJECTS_RING_SIZE > 0
+    LibObjectsRing DigitalInputRing;
+    AwaObjectInstanceID DigitalInputSamples[LIBOBJECTS_RING_SIZE];
+    LibObjectsRing PresenceRing;
+    IPSOPresenceSample PresenceSamples[LIBOBJECTS_RING_SIZE];
+#endif
+
+    IPSOSensor Sensors[IPSO_SENSOR_OBJECTS];
+    /* Instances of all sensor objects, each object owns a contiguous range of it */
+    IPSOSensorInstance SensorInstances[IPSO_SENSOR_INSTANCES];
+    size_t SensorInstancesUsed;
+
+    LibObjectsTimerWheel Timers;
+
+    uint32_t DirtyObjects;
+    /* Objects with periodic notifications, flushed even if not dirty */
+    uint32_t ScheduledObjects;
+    /* Bit per element of SensorInstances, set if the instance has dirty resources */
+    uint32_t SensorInstancesDirty[LIBOBJECTS_BITMAP_WORDS(IPSO_SENSOR_INSTANCES)];
+    /* Bit per element of SensorInstances, set if the instance has a maximal notification period or a window */
+    uint32_t SensorInstancesScheduled[LIBOBJECTS_BITMAP_WORDS(IPSO_SENSOR_INSTANCES)];
+};
+
+/***************************************************************************************************
+ * Globals
+ **************************************************************************************************/
+
+extern const LibObjectsString LibObjectsStrings[LIBOBJECTS_STRING_COUNT];
+
+/***************************************************************************************************
+ * Functions
+ **************************************************************************************************/
+
+/**
+ * @brief Looks up context attached to AWA client.
+ * @param awaClient Reference to AWA client handle
+ * @return Attached context, or the default context if none was attached to the client.
+ */
+LibObjectsContext *LibObjects_GetContext(AwaStaticClient *awaClient);
+
+/**
+ * @brief Current time of the clock set with LibObjects_SetClock.
+ */
+LibObjectsTime LibObjects_GetTime(void);
+
+/**
+ * @brief Copies size characters of data to a LIBOBJECTS_STRING_BUFFER, use it through LIBOBJECTS_STRING_STORE.
+ * @return False, leaving the buffer unchanged, if data does not fit.
+ */
+bool LibObjectsString_Store(char *value, uint16_t *length, size_t capacity, const void *data, size_t size);
+
+/**
+ * @brief Defines all resources of a table and binds them to handler.
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError LibObjects_DefineResources(AwaStaticClient *awaClient, const LibObjectsResourceTable *table, AwaStaticClientHandler handler);
+
+/**
+ * @brief Serves Read, Write, Execute and CreateResource operations on a resource of table bound to instance. Object
+ *  handlers call it for all operations on resources they do not handle themselves.
+ * @return Result of the operation, AwaResult_NotFound if resourceID is not in table.
+ */
+AwaResult LibObjects_HandleResource(AwaStaticClient *awaClient, const LibObjectsResourceTable *table, void *instance, AwaOperation operation,
+    AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, void **dataPointer, size_t *dataSize, bool *changed);
+
+/**
+ * @brief Sends ResourceChanged for every set bit of dirty, bit n stands for resources[n].
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError LibObjects_NotifyDirty(AwaStaticClient *awaClient, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, uint32_t dirty,
+    const AwaResourceID *resources);
+
+void IPSOSensor_Flush(AwaStaticClient *awaClient, LibObjectsContext *context);
+void DigitalInput_Flush(AwaStaticClient *awaClient, LibObjectsContext *context);
+void PresenceObject_Flush(AwaStaticClient *awaClient, LibObjectsContext *context);
+void SetPointObject_Flush(AwaStaticClient *awaClient, LibObjectsContext *context);
+void DeviceObject_Flush(AwaStaticClient *awaClient, LibObjectsContext *context);
+
+/**
+ * @brief Schedules timer to call callback once LibObjects_Tick reaches deadline, replacing its previous schedule.
+ *  Deadlines not after the last LibObjects_Tick are run by the next one with a later time. Constant time. Timers are
+ *  only scheduled, cancelled and run on the thread running AwaStaticClient_Process.
+ * @param context Context of the object owning timer
+ * @param timer Timer, zeroed or used with context before
+ * @param deadline Time in ms on the clock passed to LibObjects_Tick
+ * @param callback Function to call
+ */
+void LibObjectsTimer_Schedule(LibObjectsContext *context, LibObjectsTimer *timer, LibObjectsTime deadline, LibObjectsTimerCallback callback);
+
+/**
+ * @brief Stops timer if it is scheduled. Constant time.
+ */
+void LibObjectsTimer_Cancel(LibObjectsContext *context, LibObjectsTimer *timer);
+
+/**
+ * @brief Adds to a counter, safe to call from any thread with LIBOBJECTS_THREAD_SAFE.
+ */
+void LibObjectsCounter_Add(LibObjectsCounter *counter, int64_t count);
+
+/**
+ * @brief Gets value of a counter, counts added concurrently may or may not be included.
+ */
+int64_t LibObjectsCounter_Read(LibObjectsCounter *counter);
+
+/**
+ * @brief Sets counter to 0. Only one thread may reset or read the counter at a time.
+ */
+void LibObjectsCounter_Reset(LibObjectsCounter *counter);
+
+#if LIBOBJECTS_RING_SIZE > 0
+/**
+ * @brief Producer side: checks for a free entry in the queue.
+ * @param ring Queue indices
+ * @param head Receives index of the free entry
+ * @return True if the entry at LIBOBJECTS_RING_SLOT(*head) may be written.
+ */
+bool LibObjectsRing_Reserve(LibObjectsRing *ring, uint32_t *head);
+
+/**
+ * @brief Producer side: publishes entry previously reserved with LibObjectsRing_Reserve.
+ */
+void LibObjectsRing_Commit(LibObjectsRing *ring, uint32_t head);
+
+/**
+ * @brief Consumer side: gets the range of queued entries, from *tail up to the returned index.
+ */
+uint32_t LibObjectsRing_Peek(LibObjectsRing *ring, uint32_t *tail);
+
+/**
+ * @brief Consumer side: frees all entries before tail.
+ */
+void LibObjectsRing_Release(LibObjectsRing *ring, uint32_t tail);
+
+void IPSOSensor_Drain(AwaStaticClient *awaClient, LibObjectsContext *context);
+void DigitalInput_Drain(AwaStaticClient *awaClient, LibObjectsContext *context);
+void PresenceObject_Drain(AwaStaticClient *awaClient, LibObjectsContext *context);
+#endif
+
+#endif /* LWM2M_CLIENT_LIBOBJECTS_PRIVATE_H_ */
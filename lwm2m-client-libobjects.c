@@ -0,0 +1,772 @@
+/**
+ * @file
+ * LightWeightM2M LWM2M libobjects per-client context.
+ *
+ * @author Imagination Technologies
+ *
+ * @copyright Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group
+ * companies and/or licensors.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/***************************************************************************************************
+ * Includes
+ **************************************************************************************************/
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <awa/static.h>
+#include "lwm2m-client-libobjects-private.h"
+#include "lwm2m-client-device-object.h"
+
+/***************************************************************************************************
+ * Definitions
+ **************************************************************************************************/
+
+#define LIBOBJECTS_MIN_BINDINGS     16
+
+/***************************************************************************************************
+ * Typedefs
+ **************************************************************************************************/
+
+typedef struct
+{
+    AwaStaticClient *Client;
+    LibObjectsContext *Context;
+} LibObjectsBinding;
+
+struct _LibObjectsPool
+{
+    size_t Count;
+    size_t Used;                    /* Contexts below Used were handed out at least once */
+    LibObjectsContext *FreeList;
+    LibObjectsContext Contexts[];
+};
+
+/***************************************************************************************************
+ * Globals
+ **************************************************************************************************/
+
+const LibObjectsString LibObjectsStrings[LIBOBJECTS_STRING_COUNT] = {
+    [LIBOBJECTS_STRING_EMPTY] = LIBOBJECTS_STRING(""),
+    [LIBOBJECTS_STRING_CELSIUS] = LIBOBJECTS_STRING("Celsius deg"),
+    [LIBOBJECTS_STRING_TEMPERATURE_DELTA_TRIGGER] = LIBOBJECTS_STRING("Temperature Delta Trigger"),
+    [LIBOBJECTS_STRING_DEVICE_MANUFACTURER] = LIBOBJECTS_STRING(LWM2M_DEVICE_MANUFACTURER),
+    [LIBOBJECTS_STRING_DEVICE_MODEL_NUMBER] = LIBOBJECTS_STRING(LWM2M_DEVICE_MODEL_NUMBER),
+    [LIBOBJECTS_STRING_DEVICE_SERIAL_NUMBER] = LIBOBJECTS_STRING(LWM2M_DEVICE_SERIAL_NUMBER),
+    [LIBOBJECTS_STRING_DEVICE_FIRMWARE_VERSION] = LIBOBJECTS_STRING(LWM2M_DEVICE_FIRMWARE_VERSION),
+    [LIBOBJECTS_STRING_DEVICE_BINDING_AND_MODES] = LIBOBJECTS_STRING("U"),
+    [LIBOBJECTS_STRING_DEVICE_TYPE] = LIBOBJECTS_STRING(LWM2M_DEVICE_TYPE),
+    [LIBOBJECTS_STRING_DEVICE_HARDWARE_VERSION] = LIBOBJECTS_STRING(LWM2M_DEVICE_HARDWARE_VERSION),
+    [LIBOBJECTS_STRING_DEVICE_SOFTWARE_VERSION] = LIBOBJECTS_STRING(LWM2M_DEVICE_SOFTWARE_VERSION),
+    [LIBOBJECTS_STRING_DIGITAL_INPUT_APPLICATION_TYPE] = LIBOBJECTS_STRING(DIGITAL_INPUT_APPLICATION_TYPE),
+    [LIBOBJECTS_STRING_DIGITAL_INPUT_SENSOR_TYPE] = LIBOBJECTS_STRING(DIGITAL_INPUT_SENSOR_TYPE),
+    [LIBOBJECTS_STRING_LIGHT_CONTROL_UNITS] = LIBOBJECTS_STRING(LIGHT_CONTROL_UNITS),
+};
+
+static LibObjectsContext DefaultContext;
+
+static LibObjectsClock Clock;
+
+/* Open addressing table of client to context bindings, its size is always a power of two */
+static LibObjectsBinding *Bindings;
+static size_t BindingsSize;
+static size_t BindingsUsed;
+
+/***************************************************************************************************
+ * Implementation
+ **************************************************************************************************/
+
+static size_t LibObjects_Hash(AwaStaticClient *awaClient)
+{
+    return (size_t)(((uintptr_t)awaClient >> 4) * 2654435761u);
+}
+
+static LibObjectsBinding *LibObjects_FindBinding(AwaStaticClient *awaClient)
+{
+    size_t mask = BindingsSize - 1;
+    size_t i;
+
+    if (BindingsUsed == 0)
+    {
+        return NULL;
+    }
+
+    for (i = LibObjects_Hash(awaClient) & mask; Bindings[i].Client != NULL; i = (i + 1) & mask)
+    {
+        if (Bindings[i].Client == awaClient)
+        {
+            return &Bindings[i];
+        }
+    }
+    return NULL;
+}
+
+static void LibObjects_InsertBinding(AwaStaticClient *awaClient, LibObjectsContext *context)
+{
+    size_t mask = BindingsSize - 1;
+    size_t i;
+
+    for (i = LibObjects_Hash(awaClient) & mask; Bindings[i].Client != NULL; i = (i + 1) & mask)
+    {
+    }
+    Bindings[i].Client = awaClient;
+    Bindings[i].Context = context;
+    BindingsUsed++;
+}
+
+static bool LibObjects_GrowBindings(void)
+{
+    LibObjectsBinding *oldBindings = Bindings;
+    size_t oldSize = BindingsSize;
+    size_t newSize = (oldSize == 0) ? LIBOBJECTS_MIN_BINDINGS : oldSize * 2;
+    size_t i;
+
+    Bindings = calloc(newSize, sizeof(LibObjectsBinding));
+    if (Bindings == NULL)
+    {
+        Bindings = oldBindings;
+        return false;
+    }
+    BindingsSize = newSize;
+    BindingsUsed = 0;
+    for (i = 0; i < oldSize; i++)
+    {
+        if (oldBindings[i].Client != NULL)
+        {
+            LibObjects_InsertBinding(oldBindings[i].Client, oldBindings[i].Context);
+        }
+    }
+    free(oldBindings);
+    return true;
+}
+
+LibObjectsContext *LibObjects_GetContext(AwaStaticClient *awaClient)
+{
+    LibObjectsBinding *binding = LibObjects_FindBinding(awaClient);
+    return (binding != NULL) ? binding->Context : &DefaultContext;
+}
+
+AwaError LibObjects_Attach(AwaStaticClient *awaClient, LibObjectsContext *context)
+{
+    LibObjectsBinding *binding;
+
+    if ((awaClient == NULL) || (context == NULL))
+    {
+        printf("Invalid arguments passed to %s", __func__);
+        return AwaError_Unspecified;
+    }
+
+    binding = LibObjects_FindBinding(awaClient);
+    if (binding != NULL)
+    {
+        binding->Context = context;
+        return AwaError_Success;
+    }
+
+    // Keep the table at most half full so probe sequences stay short
+    if (((BindingsUsed + 1) * 2 > BindingsSize) && !LibObjects_GrowBindings())
+    {
+        printf("Failed to attach libobjects context\n");
+        return AwaError_OutOfMemory;
+    }
+    LibObjects_InsertBinding(awaClient, context);
+    return AwaError_Success;
+}
+
+void LibObjects_Detach(AwaStaticClient *awaClient)
+{
+    LibObjectsBinding *binding = LibObjects_FindBinding(awaClient);
+    size_t mask = BindingsSize - 1;
+    size_t hole;
+    size_t i;
+
+    if (binding == NULL)
+    {
+        return;
+    }
+
+    // Shift following entries of the probe sequence back so lookups never stop at the hole
+    hole = binding - Bindings;
+    Bindings[hole].Client = NULL;
+    BindingsUsed--;
+    for (i = (hole + 1) & mask; Bindings[i].Client != NULL; i = (i + 1) & mask)
+    {
+        size_t home = LibObjects_Hash(Bindings[i].Client) & mask;
+        bool reachable = (hole <= i) ? ((hole < home) && (home <= i)) : ((hole < home) || (home <= i));
+        if (!reachable)
+        {
+            Bindings[hole] = Bindings[i];
+            Bindings[i].Client = NULL;
+            hole = i;
+        }
+    }
+}
+
+LibObjectsPool *LibObjects_CreatePool(size_t contexts)
+{
+    LibObjectsPool *pool;
+
+    if ((contexts == 0) || (contexts > (SIZE_MAX - sizeof(LibObjectsPool)) / sizeof(LibObjectsContext)))
+    {
+        printf("Invalid arguments passed to %s", __func__);
+        return NULL;
+    }
+
+    // Contexts are cleared when acquired, so memory of unused ones is never touched
+    pool = malloc(sizeof(LibObjectsPool) + contexts * sizeof(LibObjectsContext));
+    if (pool == NULL)
+    {
+        printf("Failed to allocate pool of %zu contexts\n", contexts);
+        return NULL;
+    }
+    pool->Count = contexts;
+    pool->Used = 0;
+    pool->FreeList = NULL;
+    return pool;
+}
+
+void LibObjects_DestroyPool(LibObjectsPool *pool)
+{
+    free(pool);
+}
+
+LibObjectsContext *LibObjects_AcquireContext(LibObjectsPool *pool)
+{
+    LibObjectsContext *context = NULL;
+
+    if (pool == NULL)
+    {
+        printf("Invalid arguments passed to %s", __func__);
+        return NULL;
+    }
+
+    if (pool->FreeList != NULL)
+    {
+        context = pool->FreeList;
+        pool->FreeList = context->NextFree;
+    }
+    else if (pool->Used < pool->Count)
+    {
+        context = &pool->Contexts[pool->Used++];
+    }
+
+    if (context != NULL)
+    {
+        memset(context, 0, sizeof(*context));
+    }
+    return context;
+}
+
+void LibObjects_ReleaseContext(LibObjectsPool *pool, LibObjectsContext *context)
+{
+    if ((pool == NULL) || (context < pool->Contexts) || (context >= pool->Contexts + pool->Used))
+    {
+        printf("Invalid arguments passed to %s", __func__);
+        return;
+    }
+    context->NextFree = pool->FreeList;
+    pool->FreeList = context;
+}
+
+#if LIBOBJECTS_RING_SIZE > 0
+
+bool LibObjectsRing_Reserve(LibObjectsRing *ring, uint32_t *head)
+{
+    *head = __atomic_load_n(&ring->Head, __ATOMIC_RELAXED);
+    return (*head - __atomic_load_n(&ring->Tail, __ATOMIC_ACQUIRE)) < LIBOBJECTS_RING_SIZE;
+}
+
+void LibObjectsRing_Commit(LibObjectsRing *ring, uint32_t head)
+{
+    __atomic_store_n(&ring->Head, head + 1, __ATOMIC_RELEASE);
+}
+
+uint32_t LibObjectsRing_Peek(LibObjectsRing *ring, uint32_t *tail)
+{
+    *tail = __atomic_load_n(&ring->Tail, __ATOMIC_RELAXED);
+    return __atomic_load_n(&ring->Head, __ATOMIC_ACQUIRE);
+}
+
+void LibObjectsRing_Release(LibObjectsRing *ring, uint32_t tail)
+{
+    __atomic_store_n(&ring->Tail, tail, __ATOMIC_RELEASE);
+}
+
+#endif /* LIBOBJECTS_RING_SIZE > 0 */
+
+#if LIBOBJECTS_THREAD_SAFE
+
+/* Slot of LibObjectsCounter.Shards each thread adds to, plus one so that 0 means not assigned yet */
+static __thread uint32_t CounterShard;
+static uint32_t NextCounterShard;
+
+static uint32_t LibObjectsCounter_Shard(void)
+{
+    if (CounterShard == 0)
+    {
+        CounterShard = __atomic_fetch_add(&NextCounterShard, 1, __ATOMIC_RELAXED) % LIBOBJECTS_COUNTER_SHARDS + 1;
+    }
+    return CounterShard - 1;
+}
+
+void LibObjectsCounter_Add(LibObjectsCounter *counter, int64_t count)
+{
+    __atomic_fetch_add(&counter->Shards[LibObjectsCounter_Shard()].Value, count, __ATOMIC_RELAXED);
+}
+
+static int64_t LibObjectsCounter_Sum(LibObjectsCounter *counter)
+{
+    int64_t sum = 0;
+    int i;
+    for (i = 0; i < LIBOBJECTS_COUNTER_SHARDS; i++)
+    {
+        sum += __atomic_load_n(&counter->Shards[i].Value, __ATOMIC_RELAXED);
+    }
+    return sum;
+}
+
+#else
+
+void LibObjectsCounter_Add(LibObjectsCounter *counter, int64_t count)
+{
+    counter->Shards[0].Value += count;
+}
+
+static int64_t LibObjectsCounter_Sum(LibObjectsCounter *counter)
+{
+    return counter->Shards[0].Value;
+}
+
+#endif /* LIBOBJECTS_THREAD_SAFE */
+
+int64_t LibObjectsCounter_Read(LibObjectsCounter *counter)
+{
+    return LibObjectsCounter_Sum(counter) - counter->Base;
+}
+
+void LibObjectsCounter_Reset(LibObjectsCounter *counter)
+{
+    counter->Base = LibObjectsCounter_Sum(counter);
+}
+
+/*
+ * Links timer into the wheel at its deadline, or at floor if the deadline is earlier. The slot is picked on the lowest
+ * level where it is less than a full turn ahead of the current one, so it is never reached before it is moved down.
+ */
+static void LibObjectsTimer_Insert(LibObjectsTimerWheel *wheel, LibObjectsTimer *timer, LibObjectsTime floor)
+{
+    LibObjectsTime key = (timer->Deadline > floor) ? timer->Deadline : floor;
+    int level;
+    int shift;
+    int slot;
+
+    for (level = 0; level < LIBOBJECTS_TIMER_LEVELS; level++)
+    {
+        shift = level * LIBOBJECTS_TIMER_SLOT_BITS;
+        if ((key >> shift) - (wheel->Now >> shift) < LIBOBJECTS_TIMER_SLOTS)
+        {
+            break;
+        }
+    }
+    if (level == LIBOBJECTS_TIMER_LEVELS)
+    {
+        /* Beyond the wheel: wait in the last slot of the top level */
+        level--;
+        key = ((wheel->Now >> shift) + LIBOBJECTS_TIMER_SLOTS - 1) << shift;
+    }
+    slot = (key >> shift) & (LIBOBJECTS_TIMER_SLOTS - 1);
+
+    timer->Level = level;
+    timer->Slot = slot;
+    timer->Next = wheel->Slots[level][slot];
+    if (timer->Next != NULL)
+    {
+        timer->Next->Previous = &timer->Next;
+    }
+    timer->Previous = &wheel->Slots[level][slot];
+    wheel->Slots[level][slot] = timer;
+    wheel->Occupied[level] |= 1ull << slot;
+}
+
+static void LibObjectsTimer_Unlink(LibObjectsTimerWheel *wheel, LibObjectsTimer *timer)
+{
+    *timer->Previous = timer->Next;
+    if (timer->Next != NULL)
+    {
+        timer->Next->Previous = timer->Previous;
+    }
+    if (wheel->Slots[timer->Level][timer->Slot] == NULL)
+    {
+        wheel->Occupied[timer->Level] &= ~(1ull << timer->Slot);
+    }
+    timer->Next = NULL;
+    timer->Previous = NULL;
+}
+
+/*
+ * Earliest start of a non-empty slot after the current one on any level, no timer is due before it.
+ */
+static bool LibObjectsTimer_NextEvent(LibObjectsTimerWheel *wheel, LibObjectsTime *next)
+{
+    bool found = false;
+    int level;
+
+    for (level = 0; level < LIBOBJECTS_TIMER_LEVELS; level++)
+    {
+        int shift = level * LIBOBJECTS_TIMER_SLOT_BITS;
+        uint64_t occupied = wheel->Occupied[level];
+        LibObjectsTime start;
+        int first;
+
+        if (occupied == 0)
+        {
+            continue;
+        }
+        /* Rotate so that bit 0 is the slot following the current one */
+        first = ((wheel->Now >> shift) + 1) & (LIBOBJECTS_TIMER_SLOTS - 1);
+        if (first != 0)
+        {
+            occupied = (occupied >> first) | (occupied << (LIBOBJECTS_TIMER_SLOTS - first));
+        }
+        start = ((wheel->Now >> shift) + 1 + __builtin_ctzll(occupied)) << shift;
+        if (!found || (start < *next))
+        {
+            *next = start;
+            found = true;
+        }
+    }
+    return found;
+}
+
+void LibObjectsTimer_Schedule(LibObjectsContext *context, LibObjectsTimer *timer, LibObjectsTime deadline, LibObjectsTimerCallback callback)
+{
+    if (timer->Previous != NULL)
+    {
+        LibObjectsTimer_Unlink(&context->Timers, timer);
+    }
+    timer->Deadline = deadline;
+    timer->Callback = callback;
+    LibObjectsTimer_Insert(&context->Timers, timer, context->Timers.Now + 1);
+}
+
+void LibObjectsTimer_Cancel(LibObjectsContext *context, LibObjectsTimer *timer)
+{
+    if (timer->Previous != NULL)
+    {
+        LibObjectsTimer_Unlink(&context->Timers, timer);
+    }
+}
+
+AwaError LibObjects_Tick(AwaStaticClient *awaClient, LibObjectsTime now)
+{
+    LibObjectsTimerWheel *wheel;
+    LibObjectsContext *context;
+
+    if (awaClient == NULL)
+    {
+        printf("Invalid arguments passed to %s", __func__);
+        return AwaError_Unspecified;
+    }
+
+    context = LibObjects_GetContext(awaClient);
+    wheel = &context->Timers;
+    while (wheel->Now < now)
+    {
+        LibObjectsTime next;
+        LibObjectsTimer **slot;
+        int level;
+
+        /* Slots in between are empty, skip them */
+        if (!LibObjectsTimer_NextEvent(wheel, &next) || (next > now))
+        {
+            wheel->Now = now;
+            break;
+        }
+        wheel->Now = next;
+
+        /* Move timers of the upper level slots starting now down, they all land on lower levels or in the current slot */
+        for (level = LIBOBJECTS_TIMER_LEVELS - 1; level > 0; level--)
+        {
+            int shift = level * LIBOBJECTS_TIMER_SLOT_BITS;
+            if ((next & ((1ull << shift) - 1)) == 0)
+            {
+                slot = &wheel->Slots[level][(next >> shift) & (LIBOBJECTS_TIMER_SLOTS - 1)];
+                while (*slot != NULL)
+                {
+                    LibObjectsTimer *timer = *slot;
+                    LibObjectsTimer_Unlink(wheel, timer);
+                    LibObjectsTimer_Insert(wheel, timer, next);
+                }
+            }
+        }
+
+        /* Callbacks may schedule and cancel any timer, the slot is taken one timer at a time */
+        slot = &wheel->Slots[0][next & (LIBOBJECTS_TIMER_SLOTS - 1)];
+        while (*slot != NULL)
+        {
+            LibObjectsTimer *timer = *slot;
+            LibObjectsTimer_Unlink(wheel, timer);
+            timer->Callback(awaClient, context, timer);
+        }
+    }
+    return AwaError_Success;
+}
+
+bool LibObjects_NextDeadline(AwaStaticClient *awaClient, LibObjectsTime *deadline)
+{
+    if ((awaClient == NULL) || (deadline == NULL))
+    {
+        printf("Invalid arguments passed to %s", __func__);
+        return false;
+    }
+    return LibObjectsTimer_NextEvent(&LibObjects_GetContext(awaClient)->Timers, deadline);
+}
+
+bool LibObjectsString_Store(char *value, uint16_t *length, size_t capacity, const void *data, size_t size)
+{
+    if ((size >= capacity) || ((data == NULL) && (size > 0)))
+    {
+        return false;
+    }
+    memcpy(value, data, size);
+    value[size] = '\0';
+    *length = size;
+    return true;
+}
+
+AwaError LibObjects_DefineResources(AwaStaticClient *awaClient, const LibObjectsResourceTable *table, AwaStaticClientHandler handler)
+{
+    size_t i;
+    for (i = 0; i < table->Count; i++)
+    {
+        const LibObjectsResource *resource = &table->Resources[i];
+        AwaError error = AwaStaticClient_DefineResource(awaClient, table->ObjectID, resource->ResourceID, resource->Name, resource->Type,
+            resource->Mandatory ? 1 : 0, 1, resource->Operations);
+        if (error == AwaError_Success)
+        {
+            error = AwaStaticClient_SetResourceOperationHandler(awaClient, table->ObjectID, resource->ResourceID, handler);
+        }
+        if (error != AwaError_Success)
+        {
+            printf("Failed to define %s resource\n", resource->Name);
+            return error;
+        }
+    }
+    return AwaError_Success;
+}
+
+static const LibObjectsResource *LibObjects_FindResource(const LibObjectsResourceTable *table, AwaResourceID resourceID)
+{
+    /* Resource IDs below Base wrap around to large slots */
+    size_t slot = (size_t)resourceID - (size_t)table->Base;
+    if ((slot >= table->IndexSize) || (table->Index[slot] == 0))
+    {
+        return NULL;
+    }
+    return &table->Resources[table->Index[slot] - 1];
+}
+
+AwaResult LibObjects_HandleResource(AwaStaticClient *awaClient, const LibObjectsResourceTable *table, void *instance, AwaOperation operation,
+    AwaObjectInstanceID objectInstanceID, AwaResourceID resourceID, void **dataPointer, size_t *dataSize, bool *changed)
+{
+    const LibObjectsResource *resource = LibObjects_FindResource(table, resourceID);
+    char *field;
+    AwaResult result;
+
+    if (resource == NULL)
+    {
+        printf("Invalid resource ID %d for object %d\n", resourceID, table->ObjectID);
+        return AwaResult_NotFound;
+    }
+    field = (char *)instance + resource->Offset;
+
+    switch (operation)
+    {
+        case AwaOperation_CreateResource:
+            return AwaResult_SuccessCreated;
+
+        case AwaOperation_Read:
+            if (resource->Operations == AwaResourceOperations_Execute)
+            {
+                return AwaResult_MethodNotAllowed;
+            }
+            if ((resource->Callback != NULL) &&
+                ((result = resource->Callback(awaClient, operation, objectInstanceID, instance, resource)) != AwaResult_Success))
+            {
+                return result;
+            }
+            if (resource->Flags & LIBOBJECTS_RESOURCE_POOLED)
+            {
+                *dataPointer = (void *)LibObjectsStrings[resource->Offset].Value;
+                *dataSize = LibObjectsStrings[resource->Offset].Length;
+            }
+            else if (resource->Flags & LIBOBJECTS_RESOURCE_STRING)
+            {
+                /* Value directly follows the uint16_t Length of a LIBOBJECTS_STRING_BUFFER */
+                *dataPointer = field + sizeof(uint16_t);
+                *dataSize = *(uint16_t *)field;
+            }
+            else
+            {
+                *dataPointer = field;
+                *dataSize = resource->Size;
+            }
+            return AwaResult_SuccessContent;
+
+        case AwaOperation_Write:
+            if (resource->Operations != AwaResourceOperations_ReadWrite)
+            {
+                return AwaResult_MethodNotAllowed;
+            }
+            if (resource->Flags & LIBOBJECTS_RESOURCE_STRING)
+            {
+                if (!LibObjectsString_Store(field + sizeof(uint16_t), (uint16_t *)field, resource->Size, *dataPointer, *dataSize))
+                {
+                    return AwaResult_BadRequest;
+                }
+            }
+            else if (*dataSize == resource->Size)
+            {
+                memcpy(field, *dataPointer, resource->Size);
+            }
+            else
+            {
+                return AwaResult_BadRequest;
+            }
+            *changed = true;
+            result = AwaResult_SuccessChanged;
+            break;
+
+        case AwaOperation_Execute:
+            if (resource->Operations != AwaResourceOperations_Execute)
+            {
+                return AwaResult_MethodNotAllowed;
+            }
+            result = AwaResult_Success;
+            break;
+
+        default:
+            return AwaResult_InternalError;
+    }
+
+    if (resource->Callback != NULL)
+    {
+        AwaResult callbackResult = resource->Callback(awaClient, operation, objectInstanceID, instance, resource);
+        if (callbackResult != AwaResult_Success)
+        {
+            result = callbackResult;
+        }
+    }
+    return result;
+}
+
+AwaError LibObjects_NotifyDirty(AwaStaticClient *awaClient, AwaObjectID objectID, AwaObjectInstanceID objectInstanceID, uint32_t dirty,
+    const AwaResourceID *resources)
+{
+    AwaError error = AwaError_Success;
+    while ((dirty != 0) && (error == AwaError_Success))
+    {
+        int bit = __builtin_ctz(dirty);
+        dirty &= dirty - 1;
+        error = AwaStaticClient_ResourceChanged(awaClient, objectID, objectInstanceID, resources[bit]);
+    }
+    return error;
+}
+
+void LibObjects_SetClock(LibObjectsClock clock)
+{
+    Clock = clock;
+}
+
+LibObjectsTime LibObjects_GetTime(void)
+{
+    struct timespec now;
+    if (Clock != NULL)
+    {
+        return Clock();
+    }
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (LibObjectsTime)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+AwaError LibObjects_Drain(AwaStaticClient *awaClient)
+{
+    if (awaClient == NULL)
+    {
+        printf("Invalid arguments passed to %s", __func__);
+        return AwaError_Unspecified;
+    }
+
+#if LIBOBJECTS_RING_SIZE > 0
+    LibObjectsContext *context = LibObjects_GetContext(awaClient);
+    IPSOSensor_Drain(awaClient, context);
+    DigitalInput_Drain(awaClient, context);
+    PresenceObject_Drain(awaClient, context);
+#endif
+    return LibObjects_Flush(awaClient);
+}
+
+AwaError LibObjects_Flush(AwaStaticClient *awaClient)
+{
+    LibObjectsContext *context;
+    uint32_t dirty;
+
+    if (awaClient == NULL)
+    {
+        printf("Invalid arguments passed to %s", __func__);
+        return AwaError_Unspecified;
+    }
+
+    context = LibObjects_GetContext(awaClient);
+    dirty = LIBOBJECTS_TAKE_BITS(&context->DirtyObjects) | context->ScheduledObjects;
+    if (dirty & LIBOBJECTS_DIRTY_SENSORS)
+    {
+        IPSOSensor_Flush(awaClient, context);
+    }
+    if (dirty & LIBOBJECTS_DIRTY_DIGITAL_INPUTS)
+    {
+        DigitalInput_Flush(awaClient, context);
+    }
+    if (dirty & LIBOBJECTS_DIRTY_PRESENCE)
+    {
+        PresenceObject_Flush(awaClient, context);
+    }
+    if (dirty & LIBOBJECTS_DIRTY_SET_POINT)
+    {
+        SetPointObject_Flush(awaClient, context);
+    }
+    if (dirty & LIBOBJECTS_DIRTY_DEVICE)
+    {
+        DeviceObject_Flush(awaClient, context);
+    }
+    return AwaError_Success;
+}
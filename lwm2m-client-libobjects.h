@@ -0,0 +1,202 @@
+/**
+ * @file
+ * LightWeightM2M LWM2M libobjects per-client context.
+ *
+ * @author Imagination Technologies
+ *
+ * @copyright Copyright (c) 2016, Imagination Technologies Limited and/or its affiliated group
+ * companies and/or licensors.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are permitted
+ * provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this list of conditions
+ *    and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list of
+ *    conditions and the following disclaimer in the documentation and/or other materials provided
+ *    with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors may be used to
+ *    endorse or promote products derived from this software without specific prior written
+ *    permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND
+ * FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ * WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY
+ * WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LWM2M_CLIENT_LIBOBJECTS_H_
+#define LWM2M_CLIENT_LIBOBJECTS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "awa/static.h"
+
+/***************************************************************************************************
+ * Macros
+ **************************************************************************************************/
+
+/*
+ * Non-zero lets threads other than the one running AwaStaticClient_Process update sensor values: Sensor Value and
+ * Min/Max Measured Value are kept consistent with a sequence lock instead of a mutex. Awa is not thread safe, so
+ * it requires LIBOBJECTS_DEFERRED_NOTIFY: updating threads only mark resources dirty and LibObjects_Flush notifies
+ * them from the thread running AwaStaticClient_Process.
+ */
+#ifndef LIBOBJECTS_THREAD_SAFE
+#define LIBOBJECTS_THREAD_SAFE                  0
+#endif
+
+/*
+ * When set, updates and executes only mark the resources they change as dirty and LibObjects_Flush sends the
+ * notifications, otherwise ResourceChanged is called right away. Set by default with LIBOBJECTS_THREAD_SAFE.
+ */
+#ifndef LIBOBJECTS_DEFERRED_NOTIFY
+#define LIBOBJECTS_DEFERRED_NOTIFY              LIBOBJECTS_THREAD_SAFE
+#endif
+
+#if LIBOBJECTS_THREAD_SAFE && !LIBOBJECTS_DEFERRED_NOTIFY
+#error LIBOBJECTS_THREAD_SAFE requires LIBOBJECTS_DEFERRED_NOTIFY
+#endif
+
+/*
+ * Number of cache line sized slots the Digital Input and Presence counters are spread over when LIBOBJECTS_THREAD_SAFE
+ * is set. Each thread adds to its own slot, and the slots are summed only when Awa reads the counter.
+ */
+#ifndef LIBOBJECTS_COUNTER_SHARDS
+#define LIBOBJECTS_COUNTER_SHARDS               4
+#endif
+
+/*
+ * Number of samples each object can queue for LibObjects_Drain (power of two), 0 leaves the sample queues out.
+ * Each queue has a single producer thread and is consumed by the thread running AwaStaticClient_Process.
+ */
+#ifndef LIBOBJECTS_RING_SIZE
+#define LIBOBJECTS_RING_SIZE                    0
+#endif
+
+/***************************************************************************************************
+ * Typedefs
+ **************************************************************************************************/
+
+/**
+ * Storage of all libobjects objects for one AwaStaticClient. A client without an attached context
+ * uses a single built-in default context, which is enough for processes running one client.
+ */
+typedef struct _LibObjectsContext LibObjectsContext;
+
+/**
+ * Fixed-size pool of contexts taken from a single allocation.
+ */
+typedef struct _LibObjectsPool LibObjectsPool;
+
+/**
+ * Monotonic time in milliseconds, used to schedule notifications.
+ */
+typedef uint64_t LibObjectsTime;
+
+/**
+ * Source of monotonic time, see LibObjects_SetClock.
+ */
+typedef LibObjectsTime (*LibObjectsClock)(void);
+
+/***************************************************************************************************
+ * Functions
+ **************************************************************************************************/
+
+/**
+ * @brief Allocates a pool of contexts with a single allocation.
+ * @param contexts Number of contexts in the pool
+ * @return New pool, or NULL if there is not enough memory.
+ */
+LibObjectsPool *LibObjects_CreatePool(size_t contexts);
+
+/**
+ * @brief Frees a pool and all of its contexts. Clients using them must be detached first.
+ * @param pool Pool returned by LibObjects_CreatePool
+ */
+void LibObjects_DestroyPool(LibObjectsPool *pool);
+
+/**
+ * @brief Takes a cleared context out of the pool.
+ * @param pool Pool returned by LibObjects_CreatePool
+ * @return Context, or NULL if all contexts of the pool are in use.
+ */
+LibObjectsContext *LibObjects_AcquireContext(LibObjectsPool *pool);
+
+/**
+ * @brief Returns context to the pool it was acquired from.
+ * @param pool Pool the context was acquired from
+ * @param context Context to release
+ */
+void LibObjects_ReleaseContext(LibObjectsPool *pool, LibObjectsContext *context);
+
+/**
+ * @brief Binds context to AWA client. It has to be called before any object is defined on the client
+ *  and must not race with other libobjects calls for any client.
+ * @param awaClient Reference to AWA client handle
+ * @param context Context which will hold storage of all objects of this client
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError LibObjects_Attach(AwaStaticClient *awaClient, LibObjectsContext *context);
+
+/**
+ * @brief Unbinds context from AWA client, the client falls back to the default context.
+ * @param awaClient Reference to AWA client handle
+ */
+void LibObjects_Detach(AwaStaticClient *awaClient);
+
+/**
+ * @brief Replaces the clock used for notification scheduling, CLOCK_MONOTONIC by default.
+ * @param clock Function returning monotonic time in milliseconds, NULL restores the default
+ */
+void LibObjects_SetClock(LibObjectsClock clock);
+
+/**
+ * @brief Applies samples queued by the Push functions of all objects and flushes the changes with LibObjects_Flush.
+ *  It has to be called from the thread running AwaStaticClient_Process, typically right next to it.
+ * @param awaClient Reference to AWA client handle
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError LibObjects_Drain(AwaStaticClient *awaClient);
+
+/**
+ * @brief Runs the timers of all objects whose deadline is not after now, such as the end of a Digital Input debounce
+ *  period. Changes they make are notified like other updates. The timers are not synchronized and are also scheduled by
+ *  write callbacks and LibObjects_Drain, so it has to be called from the thread running AwaStaticClient_Process, either
+ *  periodically or when the deadline given by LibObjects_NextDeadline has passed.
+ * @param awaClient Reference to AWA client handle
+ * @param now Current time in ms, on the clock set with LibObjects_SetClock which timestamps passed to the objects also use
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError LibObjects_Tick(AwaStaticClient *awaClient, LibObjectsTime now);
+
+/**
+ * @brief Gets the time by which LibObjects_Tick has to be called next, to arm a single timer (e.g. a timerfd) for all
+ *  timers of the objects. It may be earlier than the first deadline, in which case Tick only prepares the timers.
+ *  Like LibObjects_Tick, it has to be called from the thread running AwaStaticClient_Process.
+ * @param awaClient Reference to AWA client handle
+ * @param deadline Receives time in ms, on the clock of LibObjects_Tick
+ * @return True if a timer is scheduled, false if Tick need not be called.
+ */
+bool LibObjects_NextDeadline(AwaStaticClient *awaClient, LibObjectsTime *deadline);
+
+/**
+ * @brief Sends one ResourceChanged per dirty resource of all objects and clears their dirty bits. Any number of updates
+ *  between two flushes results in at most one notification per resource. Resources of rate limited instances are
+ *  sent once their minimal period has passed and refreshed after their maximal period. It has to be called from the
+ *  thread running AwaStaticClient_Process, with LIBOBJECTS_DEFERRED_NOTIFY or rate limits typically once per process
+ *  tick.
+ * @param awaClient Reference to AWA client handle
+ * @return If operation was sucessful then AwaError_Success is returned, to map other values please refer to AwaError type.
+ */
+AwaError LibObjects_Flush(AwaStaticClient *awaClient);
+
+#endif /* LWM2M_CLIENT_LIBOBJECTS_H_ */